@@ -29,6 +29,8 @@ The application is composed of three sections :
 #include "Click_7x10_Y_config.h"
 
 uint8_t mikroe_txt[20] = { ' ', ' ', 'M', 'i', 'k', 'r' , 'o', ' ', 'E', 'l', 'e', 'k', 't', 'r', 'o', 'n', 'i', 'k', 'a', 0};
+T_c7x10y_ctx display;
+
 void systemInit()
 {
     mikrobus_gpioInit( _MIKROBUS1, _MIKROBUS_AN_PIN, _GPIO_OUTPUT );
@@ -42,8 +44,8 @@ void systemInit()
 
 void applicationInit()
 {
-    c7x10y_spiDriverInit( (T_C7X10Y_P)&_MIKROBUS1_GPIO, (T_C7X10Y_P)&_MIKROBUS1_SPI );
-    c7x10y_clearDisplay();
+    c7x10y_init( &display, (T_C7X10Y_P)&_MIKROBUS1_GPIO, (T_C7X10Y_P)&_MIKROBUS1_SPI );
+    c7x10y_clearDisplay( &display );
 }
 
 void applicationTask()
@@ -54,43 +56,43 @@ void applicationTask()
 
 // SCROLL PROCEDURE
     endOp = 1;
-    c7x10y_drawText( &mikroe_txt[0] );
-    c7x10y_scrollEnable( _C7X10Y_SPEED_MED );
+    c7x10y_drawText( &display, &mikroe_txt[0] );
+    c7x10y_scrollEnable( &display, _C7X10Y_SPEED_MED );
     while (0 != endOp)
     {
-        endOp = c7x10y_refreshDisplay();
-        c7x10y_tick();
+        endOp = c7x10y_refreshDisplay( &display );
+        c7x10y_tick( &display );
         Delay_ms( 1 );
 
     }
-    c7x10y_scrollDisable();
-    c7x10y_clearDisplay();
+    c7x10y_scrollDisable( &display );
+    c7x10y_clearDisplay( &display );
 
 // COUNTER PROCEDURE
     for (i = 0; i < 11; i++)
     {
-        c7x10y_clearDisplay();
-        c7x10y_drawNumber( i );
+        c7x10y_clearDisplay( &display );
+        c7x10y_drawNumber( &display, i );
 
         for (j = 0; j < 30; ++j)
         {
-            c7x10y_refreshDisplay();
+            c7x10y_refreshDisplay( &display );
             Delay_ms( 1 );
         }
     }
-    c7x10y_clearDisplay();
+    c7x10y_clearDisplay( &display );
     
 // PIXELS PROCEDURE
-    c7x10y_drawPixel( 2, 3 );
-    c7x10y_drawPixel( 2, 8 );
-    c7x10y_drawPixel( 6, 3 );
-    c7x10y_drawPixel( 6, 8 );
+    c7x10y_drawPixel( &display, 2, 3 );
+    c7x10y_drawPixel( &display, 2, 8 );
+    c7x10y_drawPixel( &display, 6, 3 );
+    c7x10y_drawPixel( &display, 6, 8 );
     for (i = 0; i < 255; i++)
     {
-        c7x10y_refreshDisplay();
+        c7x10y_refreshDisplay( &display );
         Delay_ms( 1 );
     }
-    c7x10y_clearDisplay();
+    c7x10y_clearDisplay( &display );
 }
 
 void main()
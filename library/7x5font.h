@@ -1,264 +1,150 @@
 #ifndef _7X5FONT_H_
 #define _7X5FONT_H_
 
-const unsigned char font[2048] = {
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 0
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 1
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 2
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 3
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 4
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 5
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 6
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 7
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 8
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 9
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 10
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 11
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 12
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 13
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 14
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 15
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 16
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 17
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 18
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 19
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 20
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 21
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 22
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 23
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 24
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 25
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 26
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 27
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 28
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 29
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 30
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 31
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 32  ( )
-   0x04,0x04,0x04,0x04,0x00,0x00,0x04,0x00,                                         // Code for char num 33  (!)
-   0x0A,0x0A,0x0A,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 34  (")
-   0x0A,0x0A,0x1F,0x0A,0x1F,0x0A,0x0A,0x00,                                         // Code for char num 35  (#)
-   0x04,0x1E,0x05,0x0E,0x14,0x0F,0x04,0x00,                                         // Code for char num 36  ($)
-   0x03,0x13,0x08,0x04,0x02,0x19,0x18,0x00,                                         // Code for char num 37  (%)
-   0x06,0x09,0x05,0x02,0x15,0x09,0x16,0x00,                                         // Code for char num 38  (&)
-   0x06,0x04,0x02,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 39  (')
-   0x08,0x04,0x02,0x02,0x02,0x04,0x08,0x00,                                         // Code for char num 40  (()
-   0x02,0x04,0x08,0x08,0x08,0x04,0x02,0x00,                                         // Code for char num 41  ())
-   0x00,0x04,0x15,0x0E,0x15,0x04,0x00,0x00,                                         // Code for char num 42  (*)
-   0x00,0x04,0x04,0x1F,0x04,0x04,0x00,0x00,                                         // Code for char num 43  (+)
-   0x00,0x00,0x00,0x00,0x06,0x04,0x02,0x00,                                         // Code for char num 44  (,)
-   0x00,0x00,0x00,0x1F,0x00,0x00,0x00,0x00,                                         // Code for char num 45  (-)
-   0x00,0x00,0x00,0x00,0x00,0x06,0x06,0x00,                                         // Code for char num 46  (.)
-   0x00,0x10,0x08,0x04,0x02,0x01,0x00,0x00,                                         // Code for char num 47  (/)
-   0x0E,0x11,0x19,0x15,0x13,0x11,0x0E,0x00,                                         // Code for char num 48  (0)
-   0x04,0x06,0x04,0x04,0x04,0x04,0x0E,0x00,                                         // Code for char num 49  (1)
-   0x0E,0x11,0x10,0x08,0x04,0x02,0x1F,0x00,                                         // Code for char num 50  (2)
-   0x1F,0x08,0x04,0x08,0x10,0x11,0x0E,0x00,                                         // Code for char num 51  (3)
-   0x08,0x0C,0x0A,0x09,0x1F,0x08,0x08,0x00,                                         // Code for char num 52  (4)
-   0x1F,0x01,0x0F,0x10,0x10,0x11,0x0E,0x00,                                         // Code for char num 53  (5)
-   0x0C,0x02,0x01,0x0F,0x11,0x11,0x0E,0x00,                                         // Code for char num 54  (6)
-   0x1F,0x10,0x08,0x04,0x02,0x02,0x02,0x00,                                         // Code for char num 55  (7)
-   0x0E,0x11,0x11,0x0E,0x11,0x11,0x0E,0x00,                                         // Code for char num 56  (8)
-   0x0E,0x11,0x11,0x1E,0x10,0x08,0x06,0x00,                                         // Code for char num 57  (9)
-   0x00,0x06,0x06,0x00,0x06,0x06,0x00,0x00,                                         // Code for char num 58  (:)
-   0x00,0x06,0x06,0x00,0x06,0x04,0x02,0x00,                                         // Code for char num 59  (;)
-   0x08,0x04,0x02,0x01,0x02,0x04,0x08,0x00,                                         // Code for char num 60  (<)
-   0x00,0x00,0x1F,0x00,0x1F,0x00,0x00,0x00,                                         // Code for char num 61  (=)
-   0x02,0x04,0x08,0x10,0x08,0x04,0x02,0x00,                                         // Code for char num 62  (>)
-   0x0E,0x11,0x10,0x08,0x04,0x00,0x04,0x00,                                         // Code for char num 63  (?)
-   0x0E,0x11,0x10,0x16,0x15,0x15,0x0E,0x00,                                         // Code for char num 64  (@)
-   0x0E,0x11,0x11,0x11,0x1F,0x11,0x11,0x00,                                         // Code for char num 65  (A)
-   0x0F,0x11,0x11,0x0F,0x11,0x11,0x0F,0x00,                                         // Code for char num 66  (B)
-   0x0E,0x11,0x01,0x01,0x01,0x11,0x0E,0x00,                                         // Code for char num 67  (C)
-   0x07,0x09,0x11,0x11,0x11,0x09,0x07,0x00,                                         // Code for char num 68  (D)
-   0x1F,0x01,0x01,0x0F,0x01,0x01,0x1F,0x00,                                         // Code for char num 69  (E)
-   0x1F,0x01,0x01,0x0F,0x01,0x01,0x01,0x00,                                         // Code for char num 70  (F)
-   0x0E,0x11,0x01,0x1D,0x11,0x11,0x1E,0x00,                                         // Code for char num 71  (G)
-   0x11,0x11,0x11,0x1F,0x11,0x11,0x11,0x00,                                         // Code for char num 72  (H)
-   0x0E,0x04,0x04,0x04,0x04,0x04,0x0E,0x00,                                         // Code for char num 73  (I)
-   0x1C,0x08,0x08,0x08,0x08,0x09,0x06,0x00,                                         // Code for char num 74  (J)
-   0x11,0x09,0x05,0x03,0x05,0x09,0x11,0x00,                                         // Code for char num 75  (K)
-   0x01,0x01,0x01,0x01,0x01,0x01,0x1F,0x00,                                         // Code for char num 76  (L)
-   0x11,0x1B,0x15,0x15,0x11,0x11,0x11,0x00,                                         // Code for char num 77  (M)
-   0x11,0x11,0x13,0x15,0x19,0x11,0x11,0x00,                                         // Code for char num 78  (N)
-   0x0E,0x11,0x11,0x11,0x11,0x11,0x0E,0x00,                                         // Code for char num 79  (O)
-   0x0F,0x11,0x11,0x0F,0x01,0x01,0x01,0x00,                                         // Code for char num 80  (P)
-   0x0E,0x11,0x11,0x11,0x15,0x09,0x16,0x00,                                         // Code for char num 81  (Q)
-   0x0F,0x11,0x11,0x0F,0x05,0x09,0x11,0x00,                                         // Code for char num 82  (R)
-   0x1E,0x01,0x01,0x0E,0x10,0x10,0x0F,0x00,                                         // Code for char num 83  (S)
-   0x1F,0x04,0x04,0x04,0x04,0x04,0x04,0x00,                                         // Code for char num 84  (T)
-   0x11,0x11,0x11,0x11,0x11,0x11,0x0E,0x00,                                         // Code for char num 85  (U)
-   0x11,0x11,0x11,0x11,0x11,0x0A,0x04,0x00,                                         // Code for char num 86  (V)
-   0x11,0x11,0x11,0x15,0x15,0x15,0x0A,0x00,                                         // Code for char num 87  (W)
-   0x11,0x11,0x0A,0x04,0x0A,0x11,0x11,0x00,                                         // Code for char num 88  (X)
-   0x11,0x11,0x11,0x0A,0x04,0x04,0x04,0x00,                                         // Code for char num 89  (Y)
-   0x1F,0x10,0x08,0x04,0x02,0x01,0x1F,0x00,                                         // Code for char num 90  (Z)
-   0x0E,0x02,0x02,0x02,0x02,0x02,0x0E,0x00,                                         // Code for char num 91  ([)
-   0x00,0x01,0x02,0x04,0x08,0x10,0x00,0x00,                                         // Code for char num 92  (\)
-   0x0E,0x08,0x08,0x08,0x08,0x08,0x0E,0x00,                                         // Code for char num 93  (])
-   0x04,0x0A,0x11,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 94  (^)
-   0x00,0x00,0x00,0x00,0x00,0x00,0x1F,0x00,                                         // Code for char num 95  (_)
-   0x0C,0x04,0x08,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 96  (`)
-   0x00,0x00,0x0E,0x10,0x1E,0x11,0x1E,0x00,                                         // Code for char num 97  (a)
-   0x01,0x01,0x0F,0x11,0x11,0x11,0x0F,0x00,                                         // Code for char num 98  (b)
-   0x00,0x00,0x1E,0x01,0x01,0x01,0x1E,0x00,                                         // Code for char num 99  (c)
-   0x10,0x10,0x1E,0x11,0x11,0x11,0x1E,0x00,                                         // Code for char num 100 (d)
-   0x00,0x00,0x0E,0x11,0x1F,0x01,0x0E,0x00,                                         // Code for char num 101 (e)
-   0x18,0x04,0x1F,0x04,0x04,0x04,0x04,0x00,                                         // Code for char num 102 (f)
-   0x00,0x00,0x1E,0x11,0x1E,0x10,0x0E,0x00,                                         // Code for char num 103 (g)
-   0x01,0x01,0x0D,0x13,0x11,0x11,0x11,0x00,                                         // Code for char num 104 (h)
-   0x04,0x00,0x06,0x04,0x04,0x04,0x0E,0x00,                                         // Code for char num 105 (i)
-   0x08,0x00,0x0C,0x08,0x08,0x09,0x06,0x00,                                         // Code for char num 106 (j)
-   0x02,0x02,0x12,0x0A,0x06,0x0A,0x12,0x00,                                         // Code for char num 107 (k)
-   0x06,0x04,0x04,0x04,0x04,0x04,0x0E,0x00,                                         // Code for char num 108 (l)
-   0x00,0x00,0x0B,0x15,0x15,0x15,0x15,0x00,                                         // Code for char num 109 (m)
-   0x00,0x00,0x0D,0x13,0x11,0x11,0x11,0x00,                                         // Code for char num 110 (n)
-   0x00,0x00,0x0E,0x11,0x11,0x11,0x0E,0x00,                                         // Code for char num 111 (o)
-   0x00,0x00,0x0F,0x11,0x0F,0x01,0x01,0x00,                                         // Code for char num 112 (p)
-   0x00,0x00,0x1E,0x11,0x1E,0x10,0x10,0x00,                                         // Code for char num 113 (q)
-   0x00,0x00,0x1A,0x06,0x02,0x02,0x02,0x00,                                         // Code for char num 114 (r)
-   0x00,0x00,0x0E,0x01,0x0E,0x10,0x0F,0x00,                                         // Code for char num 115 (s)
-   0x04,0x04,0x1F,0x04,0x04,0x04,0x18,0x00,                                         // Code for char num 116 (t)
-   0x00,0x00,0x11,0x11,0x11,0x19,0x16,0x00,                                         // Code for char num 117 (u)
-   0x00,0x00,0x11,0x11,0x11,0x0A,0x04,0x00,                                         // Code for char num 118 (v)
-   0x00,0x00,0x11,0x11,0x15,0x15,0x0A,0x00,                                         // Code for char num 119 (w)
-   0x00,0x00,0x11,0x0A,0x04,0x0A,0x11,0x00,                                         // Code for char num 120 (x)
-   0x00,0x00,0x11,0x11,0x1E,0x10,0x0E,0x00,                                         // Code for char num 121 (y)
-   0x00,0x00,0x1F,0x08,0x04,0x02,0x1F,0x00,                                         // Code for char num 122 (z)
-   0x18,0x04,0x04,0x02,0x04,0x04,0x18,0x00,                                         // Code for char num 123 ({)
-   0x04,0x04,0x04,0x04,0x04,0x04,0x04,0x00,                                         // Code for char num 124 (|)
-   0x03,0x04,0x04,0x08,0x04,0x04,0x03,0x00,                                         // Code for char num 125 (})
-   0x02,0x15,0x08,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 126 (~)
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 127
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 128
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 129
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 130
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 131
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 132
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 133
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 134
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 135
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 136
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 137
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 138
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 139
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 140
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 141
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 142
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 143
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 144
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 145
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 146
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 147
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 148
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 149
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 150
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 151
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 152
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 153
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 154
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 155
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 156
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 157
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 158
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 159
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 160
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 161
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 162
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 163
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 164
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 165
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 166
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 167
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 168
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 169
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 170
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 171
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 172
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 173
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 174
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 175
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 176
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 177
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 178
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 179
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 180
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 181
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 182
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 183
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 184
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 185
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 186
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 187
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 188
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 189
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 190
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 191
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 192
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 193
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 194
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 195
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 196
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 197
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 198
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 199
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 200
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 201
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 202
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 203
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 204
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 205
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 206
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 207
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 208
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 209
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 210
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 211
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 212
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 213
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 214
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 215
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 216
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 217
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 218
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 219
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 220
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 221
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 222
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 223
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 224
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 225
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 226
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 227
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 228
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 229
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 230
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 231
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 232
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 233
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 234
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 235
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 236
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 237
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 238
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 239
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 240
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 241
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 242
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 243
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 244
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 245
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 246
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 247
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 248
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 249
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 250
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 251
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 252
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 253
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00,                                         // Code for char num 254
-   0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00                                          // Code for char num 255
+/*
+ * 5x7 font glyphs of codes 32 to 126 - 5 columns per glyph, bit 0 is the
+ * top row.
+ */
+const unsigned char fontGlyphs[ 95 * 5 ] = {
+   0x00,0x00,0x00,0x00,0x00,   // Code for char num 32
+   0x00,0x00,0x4F,0x00,0x00,   // Code for char num 33
+   0x00,0x07,0x00,0x07,0x00,   // Code for char num 34
+   0x14,0x7F,0x14,0x7F,0x14,   // Code for char num 35
+   0x24,0x2A,0x7F,0x2A,0x12,   // Code for char num 36
+   0x23,0x13,0x08,0x64,0x62,   // Code for char num 37
+   0x36,0x49,0x55,0x22,0x50,   // Code for char num 38
+   0x00,0x05,0x03,0x00,0x00,   // Code for char num 39
+   0x00,0x1C,0x22,0x41,0x00,   // Code for char num 40
+   0x00,0x41,0x22,0x1C,0x00,   // Code for char num 41
+   0x14,0x08,0x3E,0x08,0x14,   // Code for char num 42
+   0x08,0x08,0x3E,0x08,0x08,   // Code for char num 43
+   0x00,0x50,0x30,0x00,0x00,   // Code for char num 44
+   0x08,0x08,0x08,0x08,0x08,   // Code for char num 45
+   0x00,0x60,0x60,0x00,0x00,   // Code for char num 46
+   0x20,0x10,0x08,0x04,0x02,   // Code for char num 47
+   0x3E,0x51,0x49,0x45,0x3E,   // Code for char num 48
+   0x00,0x42,0x7F,0x40,0x00,   // Code for char num 49
+   0x42,0x61,0x51,0x49,0x46,   // Code for char num 50
+   0x21,0x41,0x45,0x4B,0x31,   // Code for char num 51
+   0x18,0x14,0x12,0x7F,0x10,   // Code for char num 52
+   0x27,0x45,0x45,0x45,0x39,   // Code for char num 53
+   0x3C,0x4A,0x49,0x49,0x30,   // Code for char num 54
+   0x01,0x71,0x09,0x05,0x03,   // Code for char num 55
+   0x36,0x49,0x49,0x49,0x36,   // Code for char num 56
+   0x06,0x49,0x49,0x29,0x1E,   // Code for char num 57
+   0x00,0x36,0x36,0x00,0x00,   // Code for char num 58
+   0x00,0x56,0x36,0x00,0x00,   // Code for char num 59
+   0x08,0x14,0x22,0x41,0x00,   // Code for char num 60
+   0x14,0x14,0x14,0x14,0x14,   // Code for char num 61
+   0x00,0x41,0x22,0x14,0x08,   // Code for char num 62
+   0x02,0x01,0x51,0x09,0x06,   // Code for char num 63
+   0x32,0x49,0x79,0x41,0x3E,   // Code for char num 64
+   0x7E,0x11,0x11,0x11,0x7E,   // Code for char num 65
+   0x7F,0x49,0x49,0x49,0x36,   // Code for char num 66
+   0x3E,0x41,0x41,0x41,0x22,   // Code for char num 67
+   0x7F,0x41,0x41,0x22,0x1C,   // Code for char num 68
+   0x7F,0x49,0x49,0x49,0x41,   // Code for char num 69
+   0x7F,0x09,0x09,0x09,0x01,   // Code for char num 70
+   0x3E,0x41,0x49,0x49,0x7A,   // Code for char num 71
+   0x7F,0x08,0x08,0x08,0x7F,   // Code for char num 72
+   0x00,0x41,0x7F,0x41,0x00,   // Code for char num 73
+   0x20,0x40,0x41,0x3F,0x01,   // Code for char num 74
+   0x7F,0x08,0x14,0x22,0x41,   // Code for char num 75
+   0x7F,0x40,0x40,0x40,0x40,   // Code for char num 76
+   0x7F,0x02,0x0C,0x02,0x7F,   // Code for char num 77
+   0x7F,0x04,0x08,0x10,0x7F,   // Code for char num 78
+   0x3E,0x41,0x41,0x41,0x3E,   // Code for char num 79
+   0x7F,0x09,0x09,0x09,0x06,   // Code for char num 80
+   0x3E,0x41,0x51,0x21,0x5E,   // Code for char num 81
+   0x7F,0x09,0x19,0x29,0x46,   // Code for char num 82
+   0x46,0x49,0x49,0x49,0x31,   // Code for char num 83
+   0x01,0x01,0x7F,0x01,0x01,   // Code for char num 84
+   0x3F,0x40,0x40,0x40,0x3F,   // Code for char num 85
+   0x1F,0x20,0x40,0x20,0x1F,   // Code for char num 86
+   0x3F,0x40,0x38,0x40,0x3F,   // Code for char num 87
+   0x63,0x14,0x08,0x14,0x63,   // Code for char num 88
+   0x07,0x08,0x70,0x08,0x07,   // Code for char num 89
+   0x61,0x51,0x49,0x45,0x43,   // Code for char num 90
+   0x00,0x7F,0x41,0x41,0x00,   // Code for char num 91
+   0x02,0x04,0x08,0x10,0x20,   // Code for char num 92
+   0x00,0x41,0x41,0x7F,0x00,   // Code for char num 93
+   0x04,0x02,0x01,0x02,0x04,   // Code for char num 94
+   0x40,0x40,0x40,0x40,0x40,   // Code for char num 95
+   0x00,0x00,0x03,0x05,0x00,   // Code for char num 96
+   0x20,0x54,0x54,0x54,0x78,   // Code for char num 97
+   0x7F,0x44,0x44,0x44,0x38,   // Code for char num 98
+   0x38,0x44,0x44,0x44,0x44,   // Code for char num 99
+   0x38,0x44,0x44,0x44,0x7F,   // Code for char num 100
+   0x38,0x54,0x54,0x54,0x18,   // Code for char num 101
+   0x04,0x04,0x7E,0x05,0x05,   // Code for char num 102
+   0x08,0x54,0x54,0x54,0x3C,   // Code for char num 103
+   0x7F,0x08,0x04,0x04,0x78,   // Code for char num 104
+   0x00,0x44,0x7D,0x40,0x00,   // Code for char num 105
+   0x20,0x40,0x44,0x3D,0x00,   // Code for char num 106
+   0x00,0x7F,0x10,0x28,0x44,   // Code for char num 107
+   0x00,0x41,0x7F,0x40,0x00,   // Code for char num 108
+   0x7C,0x04,0x78,0x04,0x78,   // Code for char num 109
+   0x7C,0x08,0x04,0x04,0x78,   // Code for char num 110
+   0x38,0x44,0x44,0x44,0x38,   // Code for char num 111
+   0x7C,0x14,0x14,0x14,0x08,   // Code for char num 112
+   0x08,0x14,0x14,0x14,0x7C,   // Code for char num 113
+   0x00,0x7C,0x08,0x04,0x04,   // Code for char num 114
+   0x48,0x54,0x54,0x54,0x20,   // Code for char num 115
+   0x04,0x04,0x3F,0x44,0x44,   // Code for char num 116
+   0x3C,0x40,0x40,0x20,0x7C,   // Code for char num 117
+   0x1C,0x20,0x40,0x20,0x1C,   // Code for char num 118
+   0x3C,0x40,0x30,0x40,0x3C,   // Code for char num 119
+   0x44,0x28,0x10,0x28,0x44,   // Code for char num 120
+   0x0C,0x50,0x50,0x50,0x3C,   // Code for char num 121
+   0x44,0x64,0x54,0x4C,0x44,   // Code for char num 122
+   0x00,0x08,0x36,0x41,0x41,   // Code for char num 123
+   0x00,0x00,0x7F,0x00,0x00,   // Code for char num 124
+   0x41,0x41,0x36,0x08,0x00,   // Code for char num 125
+   0x02,0x01,0x02,0x04,0x02    // Code for char num 126
 };
 
+/*
+ * Proportional metrics per glyph - first glyph column (high nibble) and
+ * width (low nibble).
+ */
+const unsigned char fontMetrics[ 95 ] = {
+   0x02,0x21,0x13,0x05,0x05,0x05,0x05,0x12,0x13,0x13,0x05,0x05,0x12,0x05,0x12,0x05,   // Codes 32 - 47
+   0x05,0x13,0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x12,0x12,0x04,0x05,0x14,0x05,   // Codes 48 - 63
+   0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x13,0x05,0x05,0x05,0x05,0x05,0x05,   // Codes 64 - 79
+   0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x13,0x05,0x13,0x05,0x05,   // Codes 80 - 95
+   0x22,0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x13,0x04,0x14,0x13,0x05,0x05,0x05,   // Codes 96 - 111
+   0x05,0x05,0x14,0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x05,0x14,0x21,0x04,0x05    // Codes 112 - 126
+};
+
+/*
+ * Kerning pairs - left code, right code and signed gap adjustment,
+ * ended by zero left code.
+ */
+const unsigned char fontKerning[] = {
+   'L','T',0xFF,
+   'L','V',0xFF,
+   'L','W',0xFF,
+   'L','Y',0xFF,
+   'T','.',0xFF,
+   'T',',',0xFF,
+   'F','.',0xFF,
+   'F',',',0xFF,
+   'P','.',0xFF,
+   'P',',',0xFF,
+   'V','.',0xFF,
+   'V',',',0xFF,
+   'Y','.',0xFF,
+   'Y',',',0xFF,
+   'r','.',0xFF,
+   'r',',',0xFF,
+   0x00
+};
+
+/*
+ * Codes with glyphs - glyph index of the first code of each range.
+ */
+const T_c7x10y_range fontRanges[ 1 ] = {
+   { 32, 126, 0 }
+};
 
-#endif
\ No newline at end of file
+#endif
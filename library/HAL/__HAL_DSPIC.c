@@ -56,6 +56,12 @@ static void hal_spiTransfer(uint8_t *pIn, uint8_t *pOut, uint16_t nBytes)
         *( out++ ) = fp_spiRead( *( in++ ) );
 }
 
+static void hal_spiWriteAsync(uint8_t *pBuf, uint16_t nBytes, T_hal_spiDoneFp doneCb)
+{
+    hal_spiWrite( pBuf, nBytes );
+    doneCb();
+}
+
 #endif
 #ifdef __HAL_I2C__
 
@@ -26,6 +26,8 @@ typedef struct
 
 static T_hal_spiWriteFp        fp_spiWrite;                           
 static T_hal_spiReadFp         fp_spiRead;                            
+static T_hal_spiDmaFp          fp_spiDma;
+static T_hal_spiDoneFp         fp_spiDone;
 
 static void hal_spiMap(T_HAL_P spiObj)
 {
@@ -57,6 +59,35 @@ static void hal_spiTransfer(uint8_t *pIn, uint8_t *pOut, uint16_t nBytes)
         *( out++ ) = fp_spiRead( *( in++ ) );
 }
 
+static int hal_spiDmaMap(T_hal_spiDmaFp dmaStart)
+{
+    if( 0 != fp_spiDone )
+        return 1;
+    fp_spiDma  = dmaStart;
+    return 0;
+}
+
+static void hal_spiWriteAsync(uint8_t *pBuf, uint16_t nBytes, T_hal_spiDoneFp doneCb)
+{
+    if( 0 == fp_spiDma )
+    {
+        hal_spiWrite( pBuf, nBytes );
+        doneCb();
+        return;
+    }
+    fp_spiDone = doneCb;
+    fp_spiDma( pBuf, nBytes );
+}
+
+static void hal_spiAsyncDone()
+{
+    T_hal_spiDoneFp tmp = fp_spiDone;
+
+    fp_spiDone = 0;
+    if( 0 != tmp )
+        tmp();
+}
+
 #endif
 #ifdef __HAL_I2C__
 
@@ -8,7 +8,9 @@
 
 #include "__c7x10y_driver.h"
 #include "__c7x10y_hal.c"
+#if C7X10Y_BUILTIN_FONT
 #include "7x5font.h"
+#endif
 
 /* ------------------------------------------------------------------- MACROS */
 
@@ -16,6 +18,26 @@
 #define C7X10Y_SPEED_MED   1
 #define C7X10Y_SPEED_FAST  2
 
+#define C7X10Y_ORIENT_FLIP_H   0x01
+#define C7X10Y_ORIENT_FLIP_V   0x02
+
+#define C7X10Y_BLEND_OFF   0
+#define C7X10Y_BLEND_OR    1
+#define C7X10Y_BLEND_AND   2
+#define C7X10Y_BLEND_XOR   3
+
+#define C7X10Y_BLIT_SET    0
+#define C7X10Y_BLIT_CLEAR  1
+#define C7X10Y_BLIT_XOR    2
+
+#define C7X10Y_BRIGHTNESS_MAX  15
+
+#define C7X10Y_FLICKER_HZ      70
+#define C7X10Y_DWELL_MIN       50
+#define C7X10Y_DWELL_FLOOR     2
+#define C7X10Y_BUS_RETRY       20
+#define C7X10Y_ROW_UNKNOWN     0xFF
+
 /* ---------------------------------------------------------------- VARIABLES */
 
 #ifdef   __C7X10Y_DRV_I2C__
@@ -26,29 +48,144 @@ const uint8_t _C7X10Y_SPEED_SLOW = 0;
 const uint8_t _C7X10Y_SPEED_MED  = 1;
 const uint8_t _C7X10Y_SPEED_FAST = 2;
 
-static bool    scroll;
-static uint8_t frame[7][2];
-static uint8_t textFrame[7][40];
-static uint8_t textLength;
+const uint8_t _C7X10Y_ORIENT_NORMAL = 0;
+const uint8_t _C7X10Y_ORIENT_FLIP_H = 1;
+const uint8_t _C7X10Y_ORIENT_FLIP_V = 2;
+const uint8_t _C7X10Y_ORIENT_ROT180 = 3;
+
+const uint8_t _C7X10Y_BLEND_OFF = 0;
+const uint8_t _C7X10Y_BLEND_OR  = 1;
+const uint8_t _C7X10Y_BLEND_AND = 2;
+const uint8_t _C7X10Y_BLEND_XOR = 3;
+
+const uint8_t _C7X10Y_LAYER_BACKGROUND = 0;
+const uint8_t _C7X10Y_LAYER_CONTENT    = 1;
+const uint8_t _C7X10Y_LAYER_OVERLAY    = 2;
+
+const uint8_t _C7X10Y_BLIT_SET   = 0;
+const uint8_t _C7X10Y_BLIT_CLEAR = 1;
+const uint8_t _C7X10Y_BLIT_XOR   = 2;
+
+const uint8_t _C7X10Y_BRIGHTNESS_MAX = C7X10Y_BRIGHTNESS_MAX;
+
+const T_c7x10y_timing _C7X10Y_TIMING_FAST = { 0, 250, 0, 0 };
+const T_c7x10y_timing _C7X10Y_TIMING_SAFE = { 1, 1000, 0, 1 };
+
+#if C7X10Y_BUILTIN_FONT
+const T_c7x10y_font _C7X10Y_FONT_FIXED = { fontGlyphs, 0, 0, fontRanges, 1, '?' - 32 };
+const T_c7x10y_font _C7X10Y_FONT_PROP  = { fontGlyphs, fontMetrics, fontKerning, fontRanges, 1, '?' - 32 };
+#endif
+
+/**
+ * Gamma corrected brightness levels - part of the row period row stays lit
+ * (x/256, 255 is full).
+ */
+static const uint8_t gammaTable[ C7X10Y_BRIGHTNESS_MAX + 1 ] =
+{
+    0, 1, 3, 7, 14, 23, 34, 48, 64, 83, 105, 129, 156, 186, 219, 255
+};
+
+/**
+ * Column order of the 5 bit column register - straight and reversed.
+ */
+static const uint8_t colOrder[2][32] =
+{
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F
+    },
+    {
+        0x00, 0x10, 0x08, 0x18, 0x04, 0x14, 0x0C, 0x1C,
+        0x02, 0x12, 0x0A, 0x1A, 0x06, 0x16, 0x0E, 0x1E,
+        0x01, 0x11, 0x09, 0x19, 0x05, 0x15, 0x0D, 0x1D,
+        0x03, 0x13, 0x0B, 0x1B, 0x07, 0x17, 0x0F, 0x1F
+    }
+};
+
+/**
+ * Masks of the first n panel columns - horizontal runs are drawn a panel
+ * word at a time.
+ */
+static const uint16_t spanMask[11] =
+{
+    0x0000, 0x0001, 0x0003, 0x0007, 0x000F, 0x001F,
+    0x003F, 0x007F, 0x00FF, 0x01FF, 0x03FF
+};
 
 /**
- * Number of ticks for controlling scroll speed.
+ * Initialized instances scanned by ```c7x10y_scanStep``` and the instance
+ * HAL is currently mapped to. All instances share the SPI bus, so the next
+ * transfer can not start before the pending one is latched - with DMA
+ * transfers of the following panels are chained from the done callback.
  */
-static volatile uint16_t timerTick;
-static uint8_t scrollSpeed;
+static T_c7x10y_ctx *ctxList;
+static T_c7x10y_ctx *boundCtx;
+static T_C7X10Y_P boundGpio;
+static volatile bool spiBusy;
+static bool spiChain;
+static uint16_t scanElapsed;
 
 /* -------------------------------------------- PRIVATE FUNCTION DECLARATIONS */
 
 static void _memset( uint8_t* ptr, uint8_t value, uint16_t len );
 static uint16_t _strlen( char* s );
-
-static void latch( void );
-static void rowReset( void );
-static void rowClock( void );
-static void moduleReset( void );
-
-static void drawFrame( void );
-static void shiftFrame( void );
+static void _delayUs( uint16_t us );
+
+static void bind( T_c7x10y_ctx *ctx, uint8_t panel );
+static void latch( T_c7x10y_ctx *ctx );
+static void rowLatch( void );
+static void blank( T_c7x10y_ctx *ctx );
+static void blankAll( T_c7x10y_ctx *ctx );
+static void rowReset( T_c7x10y_ctx *ctx );
+static void rowClock( T_c7x10y_ctx *ctx );
+static void moduleReset( T_c7x10y_ctx *ctx );
+
+static bool frameDark( T_c7x10y_frame *fr );
+static void rowData( T_c7x10y_ctx *ctx, uint8_t *pData );
+static void rowPixels( T_c7x10y_ctx *ctx, uint16_t px );
+static void rowFlush( T_c7x10y_ctx *ctx );
+static void busWait( void );
+static void rowAdvance( T_c7x10y_ctx *ctx, uint8_t row );
+#if C7X10Y_GRAY_BITS > 1
+static bool rowGray( T_c7x10y_ctx *ctx, uint8_t row );
+static uint16_t planeData( T_c7x10y_ctx *ctx, uint8_t row, uint8_t plane );
+#if C7X10Y_COMPOSE
+static uint16_t scrollPlane( T_c7x10y_ctx *ctx, uint8_t row, uint8_t panel, uint8_t plane );
+#endif
+#endif
+static uint16_t dimmed( T_c7x10y_ctx *ctx, uint16_t period );
+static void governor( T_c7x10y_ctx *ctx );
+static uint16_t rowStep( T_c7x10y_ctx *ctx );
+static uint16_t scanRow( T_c7x10y_ctx *ctx );
+static void drawFrame( T_c7x10y_ctx *ctx );
+static uint8_t glyphGap( const T_c7x10y_font *fnt, uint8_t left, uint8_t right );
+static uint8_t glyphColumns( const T_c7x10y_font *fnt, uint8_t ch, uint8_t *pCol );
+static void numberDigit( T_c7x10y_ctx *ctx, uint8_t digit, uint8_t shift );
+static uint8_t nextColumn( T_c7x10y_ctx *ctx );
+static void scrollShift( T_c7x10y_ctx *ctx );
+static void scrollRewind( T_c7x10y_ctx *ctx );
+#if C7X10Y_GRAY_BITS > 1
+static void grayFlatten( T_c7x10y_frame *fr, uint8_t row, uint8_t panel, uint16_t mask );
+#endif
+static uint16_t pixelWord( T_c7x10y_frame *fr, uint8_t row, uint8_t panel );
+static uint16_t bitmapRow( const uint8_t *pRow, uint8_t w );
+static uint16_t placeRow( uint16_t bits, int16_t pos );
+static void blitTo( T_c7x10y_ctx *ctx, T_c7x10y_frame *fr, const uint8_t *bitmap, uint8_t w, uint8_t h, int16_t col, int16_t row, uint8_t op, bool clip );
+static void pixelBatch( T_c7x10y_ctx *ctx, const uint8_t *pixels, uint8_t count, uint8_t op );
+static void span( T_c7x10y_ctx *ctx, int16_t row, int16_t col0, int16_t col1, uint8_t op );
+static uint16_t viewRow( T_c7x10y_ctx *ctx, uint8_t row, uint8_t panel );
+static uint16_t scrollRow( T_c7x10y_ctx *ctx, uint8_t row, uint8_t panel );
+#if C7X10Y_COMPOSE
+static bool compose( T_c7x10y_ctx *ctx );
+#endif
+#if C7X10Y_SPRITES_MAX > 0
+static int16_t posPixel( int32_t pos );
+static void spriteSnap( T_c7x10y_ctx *ctx, int16_t *pCol, int16_t *pRow );
+#endif
+static void scrollUpdate( T_c7x10y_ctx *ctx );
+static void scrollStep( T_c7x10y_ctx *ctx );
 
 /* --------------------------------------------- PRIVATE FUNCTION DEFINITIONS */
 
@@ -75,310 +212,2415 @@ static uint16_t _strlen( char *s )
     return c;
 }
 
-static void latch( void )
+/*
+ * Maps HAL to the panel pins and instance SPI module. Bus must be idle -
+ * scan steps are postponed while a transfer is in flight, other callers
+ * wait by ```busWait```.
+ */
+static void bind( T_c7x10y_ctx *ctx, uint8_t panel )
+{
+    ctx->panel = panel;
+
+    if (boundCtx == ctx && boundGpio == ctx->panelGpio[ panel ])
+    {
+        return;
+    }
+
+    hal_spiMap( (T_HAL_P)ctx->spiObj );
+    hal_gpioMap( (T_HAL_P)ctx->panelGpio[ panel ] );
+    boundCtx  = ctx;
+    boundGpio = ctx->panelGpio[ panel ];
+}
+
+static void latch( T_c7x10y_ctx *ctx )
 {
     hal_gpio_csSet( 0 );
-    Delay_1us();
+    _delayUs( ctx->timing.latchPulse );
     hal_gpio_csSet( 1 );
-    Delay_1ms();
 }
 
-static void rowReset( void )
+/*
+ * Row transfer done callback - latches the instance HAL is mapped to and
+ * with DMA starts the transfer of the next waiting panel.
+ */
+static void rowLatch( void )
+{
+    latch( boundCtx );
+    spiBusy = false;
+
+    if (spiChain)
+    {
+        rowFlush( boundCtx );
+    }
+}
+
+/*
+ * Waits for the row transfer in flight, used outside of the scan only.
+ */
+static void busWait( void )
+{
+    while (spiBusy);
+}
+
+/*
+ * Turns all columns of the bound panel off - shifts zeros and latches them.
+ * Bus must be free.
+ */
+static void blank( T_c7x10y_ctx *ctx )
+{
+    uint8_t *pLatch = &ctx->colLatch[ ctx->panel * 2 ];
+
+    pLatch[ 0 ] = 0;
+    pLatch[ 1 ] = 0;
+    hal_spiWrite( pLatch, 2 );
+    latch( ctx );
+}
+
+static void blankAll( T_c7x10y_ctx *ctx )
+{
+    uint8_t panel;
+
+    for (panel = 0; panel < ctx->panels; panel++)
+    {
+        bind( ctx, panel );
+        blank( ctx );
+    }
+}
+
+static void rowReset( T_c7x10y_ctx *ctx )
 { 
     hal_gpio_pwmSet( 1 );
-    Delay_1us();
+    _delayUs( ctx->timing.resetPulse );
     hal_gpio_pwmSet( 0 );
 }
 
-static void rowClock( void )
+static void rowClock( T_c7x10y_ctx *ctx )
 {
     hal_gpio_anSet( 1 );
-    Delay_1us();
+    _delayUs( ctx->timing.latchPulse );
     hal_gpio_anSet( 0 );
 }
 
-static void moduleReset( void )
+static void moduleReset( T_c7x10y_ctx *ctx )
 {
     hal_gpio_rstSet( 0 );
-    Delay_1us();
+    _delayUs( ctx->timing.resetPulse );
     hal_gpio_rstSet( 1 );
 }
 
-static void drawFrame( uint8_t* fr )
+/*
+ * True when no pixel of the frame is lit.
+ */
+static bool frameDark( T_c7x10y_frame *fr )
 {
-    int i;
-    uint8_t *ptr = fr;
+    uint8_t *ptr = (uint8_t*)fr;
+    uint16_t len = sizeof( T_c7x10y_frame );
+    uint8_t acc = 0;
 
-    moduleReset();
-    rowReset();
-    
-    for (i = 0; i < 7; i++)
+    while (0 != len--)
     {
-        hal_spiWrite( ptr + (i * 2), 2 );
-        latch();
-        rowClock();
+        acc |= *ptr++;
     }
+
+    return ( 0 == acc );
 }
 
-/* 
- * 1. Shift right 1 from index 1
- * 2. Capture shifted bit from index 1
- * 3. Mask 0x40 from index 0 and or captured value
- * 4. Shift index 0 1
+/*
+ * Puts row data to the column registers of the bound panel. Nothing is
+ * shifted when the data is already latched, dark rows are shifted as zeros
+ * like any other.
+ *
+ * Transfer is done from colLatch so the buffer stays valid while DMA is
+ * running, row gets latched from the transfer done callback.
  */
-static void shiftFrame()
+static void rowData( T_c7x10y_ctx *ctx, uint8_t *pData )
 {
-    static uint16_t position = 0;
-    static uint8_t character = 0;
-    uint8_t carry;
-    int row, col;
+    uint8_t *pLatch = &ctx->colLatch[ ctx->panel * 2 ];
 
-    for (row = 0; row < 7; row++)
+    if (pData[ 0 ] == pLatch[ 0 ] && pData[ 1 ] == pLatch[ 1 ])
     {
-        for (col = 1; col > -1; col--)
-        {
-            frame[row][col] >>= 1;           // Pop the bit off
+        return;
+    }
 
-            if (1 == col)
-            {
-                carry = frame[row][0];
-                carry &= 0x01;
-                carry <<= 4;
-            }
-            else
-            {
-                int tmp = !( character % 2 ) ? character + 3 : character + 1;
-                carry = textFrame[row][tmp];
-                carry &= ( 1 << position );
-                carry <<= ( 4 - position );
-            }
+    pLatch[ 0 ] = pData[ 0 ];
+    pLatch[ 1 ] = pData[ 1 ];
+    spiBusy = true;
+    hal_spiWriteAsync( pLatch, 2, rowLatch );
+}
 
-            frame[row][col] |= carry;
-        }
-    }
+/*
+ * Converts packed row to the column register (SPI) format - first byte
+ * holds columns 6 - 10, second one columns 1 - 5. Mirrored panel takes
+ * the halves swapped and bit reversed.
+ */
+static void rowPixels( T_c7x10y_ctx *ctx, uint16_t px )
+{
+    uint8_t tmp[2];
 
-    position++;
+    tmp[ 0 ] = ctx->colMap[ (uint8_t)( px >> ctx->colShift[ 0 ] ) & 0x1F ];
+    tmp[ 1 ] = ctx->colMap[ (uint8_t)( px >> ctx->colShift[ 1 ] ) & 0x1F ];
+    rowData( ctx, tmp );
+}
 
-    if (4 < position)
-    {
-        position = 0;
-        character++;
+/*
+ * Sends row data waiting in ```rowNext``` panel by panel. Synchronous
+ * transfers are all done here, DMA transfer returns at once and the next
+ * panel is sent from the done callback, so the scan never waits for the bus.
+ */
+static void rowFlush( T_c7x10y_ctx *ctx )
+{
+    uint8_t panel;
+    uint16_t mask;
 
-        if (character > textLength)
+    for (panel = 0, mask = 0x0001; panel < ctx->panels; panel++, mask <<= 1)
+    {
+        if (0 != ( ctx->rowPending & mask ))
         {
-            for (row = 0; row < 7; row++)
+            ctx->rowPending &= ~mask;
+            bind( ctx, panel );
+            rowPixels( ctx, ctx->rowNext[ panel ] );
+
+            if (spiBusy)
             {
-                for (col = 0; col < 2; col++)
-                {
-                    frame[row][col] = textFrame[row][col];
-                }
+                return;
             }
-            character = 0;
-            scroll = false;
         }
     }
 }
 
-/* --------------------------------------------------------- PUBLIC FUNCTIONS */
-
-#ifdef   __C7X10Y_DRV_SPI__
-
-void c7x10y_spiDriverInit(T_C7X10Y_P gpioObj, T_C7X10Y_P spiObj)
+/*
+ * Moves all panels to the row - row counter is clocked from its tracked
+ * output, around the unused ones back to row 0. Counter is reset only when
+ * its output is unknown or resync is due, resync resets the module too.
+ */
+static void rowAdvance( T_c7x10y_ctx *ctx, uint8_t row )
 {
-    hal_spiMap( (T_HAL_P)spiObj );
-    hal_gpioMap( (T_HAL_P)gpioObj );
-    moduleReset();
-}
+    bool resync = ( 0 == row && ctx->resyncReq );
+    bool reset = ( resync || C7X10Y_ROW_UNKNOWN == ctx->rowCounter );
+    uint8_t steps;
+    uint8_t panel;
+    uint8_t i;
 
-#endif
-#ifdef   __C7X10Y_DRV_I2C__
+    steps = reset ? row : ( row + 10 - ctx->rowCounter ) % 10;
 
-void c7x10y_i2cDriverInit(T_C7X10Y_P gpioObj, T_C7X10Y_P i2cObj, uint8_t slave)
-{
-    _slaveAddress = slave;
-    hal_i2cMap( (T_HAL_P)i2cObj );
-    hal_gpioMap( (T_HAL_P)gpioObj );
+    for (panel = 0; panel < ctx->panels; panel++)
+    {
+        bind( ctx, panel );
 
-    // ... power ON
-    // ... configure CHIP
-}
+        if (resync)
+        {
+            moduleReset( ctx );
+        }
 
-#endif
-#ifdef   __C7X10Y_DRV_UART__
+        if (0 != ctx->timing.blankGap || reset)
+        {
+            blank( ctx );
+        }
 
-void c7x10y_uartDriverInit(T_C7X10Y_P gpioObj, T_C7X10Y_P uartObj)
-{
-    hal_uartMap( (T_HAL_P)uartObj );
-    hal_gpioMap( (T_HAL_P)gpioObj );
+        if (reset)
+        {
+            rowReset( ctx );
+        }
 
-    // ... power ON
-    // ... configure CHIP
+        for (i = 0; i < steps; i++)
+        {
+            rowClock( ctx );
+        }
+    }
+
+    ctx->rowCounter = row;
 }
 
-#endif
+#if C7X10Y_GRAY_BITS > 1
+/*
+ * True when row has any grayscale pixel - only such rows are modulated.
+ */
+static bool rowGray( T_c7x10y_ctx *ctx, uint8_t row )
+{
+    uint8_t plane;
+    uint8_t panel;
+    uint16_t acc = 0;
 
-/* ----------------------------------------------------------- IMPLEMENTATION */
+#if !C7X10Y_COMPOSE
+    // Scrolled text replaces the frame
+    if (ctx->scroll)
+    {
+        return false;
+    }
+#endif
 
-bool c7x10y_refreshDisplay()
-{
-    if (scroll)
+    for (plane = 0; plane < C7X10Y_GRAY_BITS; plane++)
     {
-        switch (scrollSpeed)
+        for (panel = 0; panel < ctx->panels; panel++)
         {
-            case C7X10Y_SPEED_SLOW:
-                if (timerTick > 7)
-                {
-                    shiftFrame();
-                    timerTick = 0;
-                }
-            break;
-            case C7X10Y_SPEED_MED:
-                if (timerTick > 5)
-                {
-                    shiftFrame();
-                    timerTick = 0;
-                }
-            break;
-            case C7X10Y_SPEED_FAST:
-                if (timerTick > 1)
-                {
-                    shiftFrame();
-                    timerTick = 0;
-                }
-            break;
+            acc |= ctx->scanFrame->gray[ plane ][ row ][ panel ];
         }
+    }
+
+    return ( 0 != acc );
+}
+
+/*
+ * Binary code modulation sub-frame - plane N is displayed for 2^N time
+ * units, all planes together take one row period.
+ */
+static uint16_t planeData( T_c7x10y_ctx *ctx, uint8_t row, uint8_t plane )
+{
+    uint8_t panel;
+    uint8_t src;
 
-        drawFrame( frame );
-        return scroll;
-    } 
-    else 
+    for (panel = 0; panel < ctx->panels; panel++)
     {
-        drawFrame( frame );
-        return true;
+        src = ctx->panelMap[ panel ];
+#if C7X10Y_COMPOSE
+        if (ctx->scroll)
+        {
+            ctx->rowNext[ panel ] = scrollPlane( ctx, row, src, plane );
+            continue;
+        }
+#endif
+        ctx->rowNext[ panel ] = ctx->scanFrame->px[ row ][ src ] | ctx->scanFrame->gray[ plane ][ row ][ src ];
     }
+
+    ctx->rowPending = (uint16_t)( ( 1UL << ctx->panels ) - 1 );
+
+    return ( ctx->timing.rowDwell / ( ( 1 << C7X10Y_GRAY_BITS ) - 1 ) ) << plane;
 }
 
-void c7x10y_clearDisplay()
+#if C7X10Y_COMPOSE
+/*
+ * Bit plane of a row with the scrolled text blended over the other layers.
+ * Text is at full brightness - OR lights gray pixels fully, AND keeps them
+ * under text only and XOR inverts their level.
+ */
+static uint16_t scrollPlane( T_c7x10y_ctx *ctx, uint8_t row, uint8_t panel, uint8_t plane )
 {
-    _memset( &frame[0][0], 0, 14 );
+    uint16_t text = viewRow( ctx, row, panel );
+    uint16_t px = ctx->scanFrame->px[ row ][ panel ];
+    uint16_t bits = ctx->scanFrame->gray[ plane ][ row ][ panel ];
+    uint16_t gray = 0;
+    uint8_t i;
+
+    switch (ctx->layerMode[ ctx->textLayer ])
+    {
+        case C7X10Y_BLEND_OR:
+            return px | bits | text;
+        case C7X10Y_BLEND_AND:
+            return ( px | bits ) & text;
+        case C7X10Y_BLEND_XOR:
+            for (i = 0; i < C7X10Y_GRAY_BITS; i++)
+            {
+                gray |= ctx->scanFrame->gray[ i ][ row ][ panel ];
+            }
+            gray &= ~px;
+
+            return ( ( px ^ text ) & ~gray ) | ( ( bits ^ text ) & gray );
+    }
+
+    return px | bits;
 }
+#endif
+#endif
 
-void c7x10y_drawPixel( uint8_t row, uint8_t col )
+/*
+ * Called at the frame start. Measures the frame period and keeps the row
+ * dwell at the nominal one - scan alone takes the target period, time spent
+ * outside of it (application loop or interrupt latency) lowers the rate.
+ * Dwell is shortened only to keep the lowest flicker free rate and never
+ * below 1 / C7X10Y_DWELL_FLOOR of the nominal one, so brightness does not
+ * follow the CPU load. When the time outside of the scan alone exceeds the
+ * flicker free period no dwell helps, nominal one is kept.
+ */
+static void governor( T_c7x10y_ctx *ctx )
 {
-    if (row > 7 || col > 10 || row == 0 || col == 0)
+    uint32_t now;
+    uint32_t measured;
+    uint32_t gap;
+    uint32_t ratio;
+    uint32_t nominal;
+    uint32_t want;
+
+    if (0 == ctx->clockFp)
+    {
+        return;
+    }
+
+    now      = ctx->clockFp();
+    measured = now - ctx->govFrameStart;
+    ctx->govFrameStart = now;
+
+    if (!ctx->govRun || 0 == ctx->scanTime)
     {
+        ctx->govRun   = true;
+        ctx->scanTime = 0;
         return;
     }
 
-    if (6 > col)
+    if (0 == ctx->framePeriod)
     {
-        frame[ row - 1 ][ 1 ] |= 0x01 << ( col - 1 );
+        ctx->framePeriod = measured;
     }
     else
     {
-        frame[ row - 1 ][ 0 ] |= 0x01 << ( col - 6 );
+        ctx->framePeriod = ( ctx->framePeriod * 7 + measured ) >> 3;
     }
-}
 
-void c7x10y_drawText( char* txt )
-{
-    char *ptext = txt;
-    uint8_t const *pfont = font;
-    int i, j, charCount;
-    textLength = _strlen( txt );
+    gap   = ( measured > ctx->scanTime ) ? measured - ctx->scanTime : 0;
+    ratio = ( ctx->scanTime << 8 ) / ctx->timing.rowDwell;
+    ctx->scanTime = 0;
 
-    if (40 < textLength)
+    if (0 == ratio)
     {
-        textLength = 40;
+        return;
     }
 
-    _memset( textFrame, 0, sizeof( textFrame ) );
+    nominal = ( ctx->targetPeriod << 8 ) / ratio;
+    want    = 1000000UL / C7X10Y_FLICKER_HZ;
+    want    = ( want > gap ) ? ( ( want - gap ) << 8 ) / ratio : 0;
 
-    for (charCount = 0; charCount < textLength; charCount++)
+    if (C7X10Y_DWELL_MIN > want || nominal < want)
     {
-        pfont = &font[ *( ptext++ ) * 8 ];
-
-        if (!( charCount % 2 )) 
-        {
-            for (i = 0; i < 7; i++)
-            {
-                textFrame[i][ ( charCount + 1 ) ] = *( pfont++ );
-            }
-        } 
-        else 
-        {
-            for (i = 0; i < 7; i++)
-            {
-                textFrame[i][ ( charCount - 1 ) ] = *( pfont++ );
-            }
-        }
+        want = nominal;
+    }
+    else if (nominal / C7X10Y_DWELL_FLOOR > want)
+    {
+        want = nominal / C7X10Y_DWELL_FLOOR;
     }
 
-    for (i = 0; i < 7; i++)
+    want = ( want + ctx->timing.rowDwell ) >> 1;
+
+    if (C7X10Y_DWELL_MIN > want)
     {
-        for (j = 0; j < 2; j++)
-        {
-            frame[i][j] = textFrame[i][j];
-        }
+        want = C7X10Y_DWELL_MIN;
     }
+    if (0xFFFF < want)
+    {
+        want = 0xFFFF;
+    }
+
+    ctx->timing.rowDwell = (uint16_t)want;
 }
 
+/*
+ * Shows the queued row data. Splits lit period to the on part which is
+ * returned and the dark part which is done as separate step. Row too short
+ * to be lit at all is not sent, all panels are dark for the whole period.
+ */
+static uint16_t dimmed( T_c7x10y_ctx *ctx, uint16_t period )
+{
+    uint16_t on;
+
+    if (255 == ctx->brightGain)
+    {
+        rowFlush( ctx );
+        return period;
+    }
+
+    on = (uint16_t)( ( (uint32_t)period * ctx->brightGain ) >> 8 );
+    ctx->scanOffTime = period - on;
+
+    if (0 == on)
+    {
+        ctx->rowPending  = 0;
+        ctx->scanOffTime = 0;
+        blankAll( ctx );
+        return period;
+    }
+
+    rowFlush( ctx );
+
+    return on;
+}
 
-void c7x10y_drawNumber( uint8_t num )
+/*
+ * One step of the row scan state machine. Each row clocks the row counter
+ * on, row 0 clocks it around through the unused outputs. Counter and module
+ * are reset only when resync is due. Data is shifted and latched and the
+ * function returns without waiting - caller is responsible for the row
+ * on-time.
+ * Panels of a tiled display are driven one after another in the same step.
+ *
+ * Dark frame is skipped as a whole - single step for the time of 7 rows.
+ * Rows with grayscale pixels take one step per bit plane. Step is postponed
+ * while a row transfer is in flight, it can not drive the pins before.
+ */
+static uint16_t rowStep( T_c7x10y_ctx *ctx )
 {
-    uint8_t const *pfont = font;
-    int i;
+    uint8_t row = ctx->scanRowIdx;
+    uint16_t period = ctx->timing.rowDwell;
+    uint8_t panel;
+    uint32_t darkTime;
 
-    if (99 < num)
+    if (spiBusy)
     {
-        return;
+        return C7X10Y_BUS_RETRY;
+    }
+
+    if (0 != ctx->scanOffTime)
+    {
+        period = ctx->scanOffTime;
+        ctx->scanOffTime = 0;
+        blankAll( ctx );
+        return period;
     }
 
-    if (10 > num)
+#if C7X10Y_GRAY_BITS > 1
+    if (0 != ctx->scanPlane)
     {
-        pfont = &font[( num + 48 ) * 8 ];
+        period = dimmed( ctx, planeData( ctx, ctx->rowMap[ row ], ctx->scanPlane ) );
 
-        for (i = 0; i < 7; i++)
+        if (C7X10Y_GRAY_BITS > ++ctx->scanPlane)
+        {
+            return period;
+        }
+        ctx->scanPlane = 0;
+
+        if (6 < ++row)
         {
-            frame[i][0] = *( pfont++ );
+            row = 0;
         }
-    } 
-    else 
+        ctx->scanRowIdx = row;
+
+        return period;
+    }
+#endif
+
+    if (0 == row)
     {
-        int tmpNum = num / 10;
-        pfont = &font[( tmpNum + 48 ) * 8 ];
+        governor( ctx );
 
-        for (i = 0; i < 7; i++)
+        if (0 != ctx->resyncFrames && ctx->resyncFrames <= ++ctx->resyncCount)
         {
-            frame[i][1] = *( pfont++ );
+            ctx->resyncReq = true;
         }
 
-        tmpNum = num % 10;
-        pfont = &font[( tmpNum + 48 ) * 8 ];
+        if (ctx->presentReq)
+        {
+#if C7X10Y_COMPOSE
+            // Drawing uses layers, composited frame is always in the other buffer
+            ctx->scanFrame  = ( ctx->scanFrame == &ctx->frameBuf[0] ) ? &ctx->frameBuf[1] : &ctx->frameBuf[0];
+#else
+            T_c7x10y_frame *tmp = ctx->scanFrame;
+
+            ctx->scanFrame  = ctx->frame;
+            ctx->frame      = tmp;
+#endif
+            ctx->presentReq = false;
+        }
 
-        for (i = 0; i < 7; i++)
+        if (0 == ctx->brightGain || ( !ctx->scroll && frameDark( ctx->scanFrame ) ))
         {
-            frame[i][0] = *( pfont++ );
+            for (panel = 0; panel < ctx->panels; panel++)
+            {
+                if (0 != ( ctx->colLatch[ panel * 2 ] | ctx->colLatch[ panel * 2 + 1 ] ))
+                {
+                    bind( ctx, panel );
+                    blank( ctx );
+                }
+            }
+
+            darkTime = 7UL * ctx->timing.rowDwell;
+
+            return ( 0xFFFF < darkTime ) ? 0xFFFF : (uint16_t)darkTime;
         }
     }
-}
 
-void c7x10y_scrollEnable( uint8_t speed )
-{
-    scroll = true;
-    scrollSpeed = speed;
-    timerTick = 0;
-}
+    rowAdvance( ctx, row );
 
-void c7x10y_scrollDisable()
-{
-    scroll = false;
-}
+    if (0 == row && ctx->resyncReq)
+    {
+        ctx->resyncCount = 0;
+        ctx->resyncReq   = false;
+    }
 
-void c7x10y_tick()
-{
-    timerTick++;
-}
+    _delayUs( ctx->timing.blankGap );
+
+#if C7X10Y_GRAY_BITS > 1
+    if (rowGray( ctx, ctx->rowMap[ row ] ))
+    {
+        ctx->scanPlane = 1;
+        return dimmed( ctx, planeData( ctx, ctx->rowMap[ row ], 0 ) );
+    }
+#endif
+    for (panel = 0; panel < ctx->panels; panel++)
+    {
+        if (ctx->scroll)
+        {
+            ctx->rowNext[ panel ] = scrollRow( ctx, ctx->rowMap[ row ], ctx->panelMap[ panel ] );
+        }
+        else
+        {
+            ctx->rowNext[ panel ] = ctx->scanFrame->px[ ctx->rowMap[ row ] ][ ctx->panelMap[ panel ] ];
+        }
+    }
+
+    ctx->rowPending = (uint16_t)( ( 1UL << ctx->panels ) - 1 );
+
+    if (6 < ++row)
+    {
+        row = 0;
+    }
+    ctx->scanRowIdx = row;
+
+    return dimmed( ctx, period );
+}
+
+static uint16_t scanRow( T_c7x10y_ctx *ctx )
+{
+    uint16_t period = rowStep( ctx );
+    ctx->scanTime += period;
+
+    return period;
+}
+
+/*
+ * Blocking refresh - each step is held by a delay, dark part of a dimmed
+ * row is done with the columns blanked so the gamma duty holds. Dark frame
+ * (or brightness 0) returns at once.
+ */
+static void drawFrame( T_c7x10y_ctx *ctx )
+{
+    uint8_t panel;
+    uint16_t period;
+
+    busWait();
+    ctx->scanRowIdx  = 0;
+    ctx->scanPlane   = 0;
+    ctx->scanOffTime = 0;
+
+    period = rowStep( ctx );
+
+    // Dark frame leaves the scan at row 0, nothing is lit
+    if (0 == ctx->scanRowIdx && 0 == ctx->scanPlane)
+    {
+        return;
+    }
+
+    for (;;)
+    {
+        ctx->scanTime += period;
+        _delayUs( period );
+
+        if (0 == ( ctx->scanRowIdx | ctx->scanPlane | ctx->scanOffTime ))
+        {
+            break;
+        }
+
+        period = rowStep( ctx );
+    }
+
+    busWait();
+
+    // Park the row counters on the unused output so the display stays dark
+    for (panel = 0; panel < ctx->panels; panel++)
+    {
+        bind( ctx, panel );
+        rowClock( ctx );
+    }
+    ctx->rowCounter++;
+}
+
+static void _delayUs( uint16_t us )
+{
+    while (1000 <= us)
+    {
+        Delay_1ms();
+        us -= 1000;
+    }
+
+    while (0 != us--)
+    {
+        Delay_1us();
+    }
+}
+
+/*
+ * Blank columns in front of the right character - character gap narrowed
+ * by the kerning pair, none at the text start.
+ */
+static uint8_t glyphGap( const T_c7x10y_font *fnt, uint8_t left, uint8_t right )
+{
+    uint8_t const *pKern = fnt->kerning;
+    int8_t gap = C7X10Y_CHAR_GAP;
+
+    if (0 == left)
+    {
+        return 0;
+    }
+
+    if (0 != pKern)
+    {
+        for (; 0 != pKern[0]; pKern += 3)
+        {
+            if (left == pKern[0] && right == pKern[1])
+            {
+                gap += (int8_t)pKern[2];
+                break;
+            }
+        }
+    }
+
+    if (0 > gap)
+    {
+        return 0;
+    }
+
+    return ( C7X10Y_CHAR_GAP < gap ) ? C7X10Y_CHAR_GAP : gap;
+}
+
+/*
+ * Copies glyph columns of a character, bit 0 is the top row. Returns the
+ * number of columns (glyph width).
+ */
+static uint8_t glyphColumns( const T_c7x10y_font *fnt, uint8_t ch, uint8_t *pCol )
+{
+    uint16_t idx = c7x10y_fontIndex( fnt, ch );
+    uint8_t const *pGlyph = &fnt->glyphs[ idx * 5 ];
+    uint8_t width = 5;
+    uint8_t i;
+
+    if (0 != fnt->metrics)
+    {
+        pGlyph += fnt->metrics[ idx ] >> 4;
+        width   = fnt->metrics[ idx ] & 0x0F;
+    }
+
+    for (i = 0; i < width; i++)
+    {
+        *pCol++ = *pGlyph++;
+    }
+
+    return width;
+}
+
+/*
+ * Places a digit glyph into the panel 0 columns from shift + 1 to shift + 5.
+ */
+static void numberDigit( T_c7x10y_ctx *ctx, uint8_t digit, uint8_t shift )
+{
+    uint8_t const *pGlyph = c7x10y_fontGlyph( ctx->textFont, '0' + digit );
+    uint16_t mask = 0x001F << shift;
+    uint16_t bits;
+    uint8_t row;
+    uint8_t i;
+
+    for (row = 0; row < 7; row++)
+    {
+        bits = 0;
+
+        for (i = 0; i < 5; i++)
+        {
+            bits |= ( ( pGlyph[ i ] >> row ) & 0x01 ) << i;
+        }
+
+#if C7X10Y_GRAY_BITS > 1
+        grayFlatten( ctx->frame, row, 0, mask );
+#endif
+        ctx->frame->px[ row ][0] = ( ctx->frame->px[ row ][0] & ~mask ) | ( bits << shift );
+    }
+}
+
+static void scrollUpdate( T_c7x10y_ctx *ctx )
+{
+    if (!ctx->scroll)
+    {
+        return;
+    }
+
+    switch (ctx->scrollSpeed)
+    {
+        case C7X10Y_SPEED_SLOW:
+            if (ctx->timerTick > 7)
+            {
+                scrollStep( ctx );
+                ctx->timerTick = 0;
+            }
+        break;
+        case C7X10Y_SPEED_MED:
+            if (ctx->timerTick > 5)
+            {
+                scrollStep( ctx );
+                ctx->timerTick = 0;
+            }
+        break;
+        case C7X10Y_SPEED_FAST:
+            if (ctx->timerTick > 1)
+            {
+                scrollStep( ctx );
+                ctx->timerTick = 0;
+            }
+        break;
+    }
+}
+
+#if C7X10Y_GRAY_BITS > 1
+/*
+ * Turns masked grayscale pixels into full brightness ones, so clear and
+ * toggle done on px take them into account.
+ */
+static void grayFlatten( T_c7x10y_frame *fr, uint8_t row, uint8_t panel, uint16_t mask )
+{
+    uint8_t plane;
+    uint16_t acc = 0;
+
+    for (plane = 0; plane < C7X10Y_GRAY_BITS; plane++)
+    {
+        acc |= fr->gray[ plane ][ row ][ panel ];
+        fr->gray[ plane ][ row ][ panel ] &= ~mask;
+    }
+
+    fr->px[ row ][ panel ] |= acc & mask;
+}
+#endif
+
+/*
+ * Lit pixels of the panel word - full brightness and grayscale ones.
+ */
+static uint16_t pixelWord( T_c7x10y_frame *fr, uint8_t row, uint8_t panel )
+{
+    uint16_t acc = fr->px[ row ][ panel ];
+#if C7X10Y_GRAY_BITS > 1
+    uint8_t plane;
+
+    for (plane = 0; plane < C7X10Y_GRAY_BITS; plane++)
+    {
+        acc |= fr->gray[ plane ][ row ][ panel ];
+    }
+#endif
+
+    return acc;
+}
+
+/*
+ * Loads one bitmap row, bit 0 is the leftmost column.
+ */
+static uint16_t bitmapRow( const uint8_t *pRow, uint8_t w )
+{
+    uint16_t bits = pRow[ 0 ];
+
+    if (8 < w)
+    {
+        bits |= (uint16_t)pRow[ 1 ] << 8;
+    }
+
+    return ( 16 == w ) ? bits : bits & ( ( 0x0001 << w ) - 1 );
+}
+
+/*
+ * Moves bitmap row to the panel word - pos is the panel column of the
+ * bitmap bit 0 and may be out of the panel on both sides.
+ */
+static uint16_t placeRow( uint16_t bits, int16_t pos )
+{
+    if (10 <= pos || -16 >= pos)
+    {
+        return 0;
+    }
+
+    if (0 <= pos)
+    {
+        return (uint16_t)( (uint32_t)bits << pos ) & 0x03FF;
+    }
+
+    return ( bits >> -pos ) & 0x03FF;
+}
+
+static void blitTo( T_c7x10y_ctx *ctx, T_c7x10y_frame *fr, const uint8_t *bitmap, uint8_t w, uint8_t h, int16_t col, int16_t row, uint8_t op, bool clip )
+{
+    uint8_t stride = ( w + 7 ) >> 3;
+    uint16_t bits;
+    uint16_t mask;
+    uint8_t panel;
+    int16_t dst;
+
+    if (0 == w || 16 < w)
+    {
+        return;
+    }
+
+    for (dst = row - 1; dst < row - 1 + h; dst++, bitmap += stride)
+    {
+        if (0 > dst || 6 < dst || ( clip && ( dst < ctx->clipTop || dst > ctx->clipBottom ) ))
+        {
+            continue;
+        }
+
+        bits = bitmapRow( bitmap, w );
+
+        for (panel = 0; panel < ctx->panels; panel++)
+        {
+            mask = placeRow( bits, col - 1 - panel * 10 );
+
+            if (clip)
+            {
+                mask &= ctx->clipMask[ panel ];
+            }
+
+#if C7X10Y_GRAY_BITS > 1
+            if (C7X10Y_BLIT_SET != op)
+            {
+                grayFlatten( fr, dst, panel, mask );
+            }
+#endif
+            switch (op)
+            {
+                case C7X10Y_BLIT_SET:
+                    fr->px[ dst ][ panel ] |= mask;
+                break;
+                case C7X10Y_BLIT_CLEAR:
+                    fr->px[ dst ][ panel ] &= ~mask;
+                break;
+                case C7X10Y_BLIT_XOR:
+                    fr->px[ dst ][ panel ] ^= mask;
+                break;
+            }
+        }
+    }
+}
+
+/*
+ * Applies blit operation to the list of row, column pairs. Coordinates are
+ * made zero based, so one unsigned compare checks both bounds.
+ */
+static void pixelBatch( T_c7x10y_ctx *ctx, const uint8_t *pixels, uint8_t count, uint8_t op )
+{
+    T_c7x10y_frame *frame = ctx->frame;
+    uint8_t width = ctx->panels * 10;
+    uint8_t row;
+    uint8_t col;
+    uint16_t *pWord;
+    uint16_t mask;
+
+    while (0 != count--)
+    {
+        row = *pixels++ - 1;
+        col = *pixels++ - 1;
+
+        if (7 <= row || width <= col)
+        {
+            continue;
+        }
+
+        pWord = &frame->px[ row ][ col / 10 ];
+        mask  = 0x0001 << ( col % 10 );
+
+#if C7X10Y_GRAY_BITS > 1
+        if (C7X10Y_BLIT_SET != op)
+        {
+            grayFlatten( frame, row, col / 10, mask );
+        }
+#endif
+        switch (op)
+        {
+            case C7X10Y_BLIT_SET:
+                *pWord |= mask;
+            break;
+            case C7X10Y_BLIT_CLEAR:
+                *pWord &= ~mask;
+            break;
+            case C7X10Y_BLIT_XOR:
+                *pWord ^= mask;
+            break;
+        }
+    }
+}
+
+/*
+ * Applies blit operation to the columns col0 to col1 of the row, zero based
+ * and clipped to the display.
+ */
+static void span( T_c7x10y_ctx *ctx, int16_t row, int16_t col0, int16_t col1, uint8_t op )
+{
+    int16_t last = ctx->panels * 10 - 1;
+    uint16_t *pWord;
+    uint16_t mask;
+    uint8_t panel;
+    uint8_t lo;
+    uint8_t hi;
+
+    if (0 > row || 6 < row)
+    {
+        return;
+    }
+
+    if (0 > col0)
+    {
+        col0 = 0;
+    }
+
+    if (last < col1)
+    {
+        col1 = last;
+    }
+
+    for (; col0 <= col1; col0 = ( panel + 1 ) * 10)
+    {
+        panel = col0 / 10;
+        lo    = col0 % 10;
+        hi    = ( col1 / 10 == panel ) ? col1 % 10 : 9;
+        pWord = &ctx->frame->px[ row ][ panel ];
+        mask  = spanMask[ hi + 1 ] & ~spanMask[ lo ];
+
+#if C7X10Y_GRAY_BITS > 1
+        if (C7X10Y_BLIT_SET != op)
+        {
+            grayFlatten( ctx->frame, row, panel, mask );
+        }
+#endif
+        switch (op)
+        {
+            case C7X10Y_BLIT_SET:
+                *pWord |= mask;
+            break;
+            case C7X10Y_BLIT_CLEAR:
+                *pWord &= ~mask;
+            break;
+            case C7X10Y_BLIT_XOR:
+                *pWord ^= mask;
+            break;
+        }
+    }
+}
+
+/*
+ * Cuts the panel window at the viewport offset out of the text ring, two
+ * ring words always hold it (one word ring holds it twice).
+ */
+static uint16_t viewRow( T_c7x10y_ctx *ctx, uint8_t row, uint8_t panel )
+{
+    uint16_t col = ctx->viewOffset + panel * 10;
+    uint8_t idx;
+    uint32_t win;
+
+    if (C7X10Y_VIEW_WORDS * 16 <= col)
+    {
+        col -= C7X10Y_VIEW_WORDS * 16;
+    }
+
+    idx = col >> 4;
+    win = ctx->view[ row ][ idx ];
+    idx = ( C7X10Y_VIEW_WORDS - 1 == idx ) ? 0 : idx + 1;
+    win |= (uint32_t)ctx->view[ row ][ idx ] << 16;
+
+    return (uint16_t)( win >> ( col & 0x0F ) ) & 0x03FF;
+}
+
+/*
+ * Row of the scrolled text. With layers text is blended by its layer mode
+ * over the other layers, which are composited without the text layer while
+ * scrolling.
+ */
+static uint16_t scrollRow( T_c7x10y_ctx *ctx, uint8_t row, uint8_t panel )
+{
+    uint16_t text = viewRow( ctx, row, panel );
+#if C7X10Y_COMPOSE
+    uint16_t px = ctx->scanFrame->px[ row ][ panel ];
+
+    switch (ctx->layerMode[ ctx->textLayer ])
+    {
+        case C7X10Y_BLEND_OR:
+            return px | text;
+        case C7X10Y_BLEND_AND:
+            return px & text;
+        case C7X10Y_BLEND_XOR:
+            return px ^ text;
+    }
+
+    return px;
+#else
+    return text;
+#endif
+}
+
+#if C7X10Y_COMPOSE
+#if C7X10Y_SPRITES_MAX > 0
+/*
+ * Pixel of a 24.8 sprite position (1 is the first one), saturated to the
+ * drawing range.
+ */
+static int16_t posPixel( int32_t pos )
+{
+    pos = ( pos >> 8 ) + 1;
+
+    if (32767 < pos)
+    {
+        return 32767;
+    }
+
+    if (-32767 > pos)
+    {
+        return -32767;
+    }
+
+    return (int16_t)pos;
+}
+
+/*
+ * Copies pixel positions of all sprites. Tick may move them from interrupt
+ * meanwhile, copy is repeated until no tick ran during it, so all positions
+ * are of the same tick and none is torn.
+ */
+static void spriteSnap( T_c7x10y_ctx *ctx, int16_t *pCol, int16_t *pRow )
+{
+    uint8_t seq;
+    uint8_t idx;
+
+    do
+    {
+        seq = ctx->spriteSeq;
+
+        for (idx = 0; idx < C7X10Y_SPRITES_MAX; idx++)
+        {
+            pCol[ idx ] = posPixel( ctx->sprite[ idx ].x );
+            pRow[ idx ] = posPixel( ctx->sprite[ idx ].y );
+        }
+    }
+    while (seq != ctx->spriteSeq);
+}
+#endif
+
+/*
+ * Blends all layers from the background up into the scan buffer which is
+ * not displayed, draws sprites over them and requests the swap. Text layer
+ * is left out while text is scrolled - scan blends it instead.
+ *
+ * Runs on the main side only. Refused while the previous composition waits
+ * for the swap, that buffer may be swapped in any time - request is kept
+ * in ```composeReq``` for the next call.
+ */
+static bool compose( T_c7x10y_ctx *ctx )
+{
+    T_c7x10y_frame *back;
+    uint16_t *pDst;
+    uint16_t *pSrc;
+    uint16_t len;
+    uint8_t layer;
+#if C7X10Y_SPRITES_MAX > 0
+    T_c7x10y_sprite *spr;
+    int16_t col[ C7X10Y_SPRITES_MAX ];
+    int16_t row[ C7X10Y_SPRITES_MAX ];
+    uint8_t idx;
+#endif
+
+    if (ctx->presentReq)
+    {
+        ctx->composeReq = true;
+        return false;
+    }
+
+    ctx->composeReq = false;
+    back = ( ctx->scanFrame == &ctx->frameBuf[0] ) ? &ctx->frameBuf[1] : &ctx->frameBuf[0];
+
+    _memset( (uint8_t*)back, 0, sizeof( T_c7x10y_frame ) );
+
+    for (layer = 0; layer < C7X10Y_LAYERS; layer++)
+    {
+        if (ctx->scroll && layer == ctx->textLayer)
+        {
+            continue;
+        }
+
+        pDst = (uint16_t*)back;
+        pSrc = (uint16_t*)&ctx->layerBuf[ layer ];
+        len  = sizeof( T_c7x10y_frame ) / 2;
+
+        switch (ctx->layerMode[ layer ])
+        {
+            case C7X10Y_BLEND_OR:
+                while (0 != len--)
+                {
+                    *pDst++ |= *pSrc++;
+                }
+            break;
+            case C7X10Y_BLEND_AND:
+                while (0 != len--)
+                {
+                    *pDst++ &= *pSrc++;
+                }
+            break;
+            case C7X10Y_BLEND_XOR:
+                while (0 != len--)
+                {
+                    *pDst++ ^= *pSrc++;
+                }
+            break;
+        }
+    }
+
+#if C7X10Y_SPRITES_MAX > 0
+    spriteSnap( ctx, col, row );
+
+    for (layer = 0; layer < C7X10Y_SPRITES_MAX; layer++)
+    {
+        idx = ctx->spriteOrder[ layer ];
+        spr = &ctx->sprite[ idx ];
+
+        if (spr->visible)
+        {
+            blitTo( ctx, back, spr->bitmap, spr->w, spr->h, col[ idx ], row[ idx ], C7X10Y_BLIT_SET, false );
+        }
+    }
+#endif
+
+    ctx->presentReq = true;
+
+    return true;
+}
+#endif
+
+/*
+ * Next column scrolled in, bit 0 is the top row. Text strip goes first,
+ * then the streamed characters rasterized one at a time as they are
+ * reached, blank columns when there is nothing more. Any text column
+ * postpones the scroll end until it has left the display and one blank
+ * character followed.
+ */
+static uint8_t nextColumn( T_c7x10y_ctx *ctx )
+{
+#if C7X10Y_STREAM_SIZE > 0
+    uint8_t tail = ctx->streamTail;
+    uint8_t ch;
+    uint8_t gap;
+#endif
+
+    if (ctx->textCol < ctx->stripLength)
+    {
+        ctx->scrollLeft = ctx->panels * 10 + C7X10Y_PITCH + 1;
+
+        return ctx->strip[ ctx->textCol++ ];
+    }
+
+#if C7X10Y_STREAM_SIZE > 0
+    if (ctx->glyphPos >= ctx->glyphLen && tail != ctx->streamHead && 0 != ctx->textFont)
+    {
+        ch  = ctx->stream[ tail & ( C7X10Y_STREAM_SIZE - 1 ) ];
+        gap = glyphGap( ctx->textFont, ctx->streamPrev, ch );
+        _memset( ctx->glyph, 0, gap );
+        ctx->glyphLen   = gap + glyphColumns( ctx->textFont, ch, &ctx->glyph[ gap ] );
+        ctx->glyphPos   = 0;
+        ctx->streamPrev = ch;
+        ctx->streamTail = tail + 1;
+    }
+
+    if (ctx->glyphPos < ctx->glyphLen)
+    {
+        ctx->scrollLeft = ctx->panels * 10 + C7X10Y_PITCH + 1;
+
+        return ctx->glyph[ ctx->glyphPos++ ];
+    }
+#endif
+
+    return 0;
+}
+
+/*
+ * Moves the viewport one column, next column is written into the ring at
+ * the right edge of the last panel. Cost does not depend on the number of
+ * panels.
+ */
+static void scrollShift( T_c7x10y_ctx *ctx )
+{
+    uint8_t bits = nextColumn( ctx );
+    uint16_t col;
+    uint16_t mask;
+    uint8_t idx;
+    uint8_t row;
+
+    if (C7X10Y_VIEW_WORDS * 16 <= ++ctx->viewOffset)
+    {
+        ctx->viewOffset = 0;
+    }
+
+    col = ctx->viewOffset + ctx->panels * 10 - 1;
+
+    if (C7X10Y_VIEW_WORDS * 16 <= col)
+    {
+        col -= C7X10Y_VIEW_WORDS * 16;
+    }
+
+    idx  = col >> 4;
+    mask = 0x0001 << ( col & 0x0F );
+
+    for (row = 0; row < 7; row++, bits >>= 1)
+    {
+        ctx->view[ row ][ idx ] = ( ctx->view[ row ][ idx ] & ~mask ) | ( ( bits & 0x01 ) ? mask : 0 );
+    }
+
+    if (0 != ctx->scrollLeft)
+    {
+        ctx->scrollLeft--;
+    }
+}
+
+/*
+ * Fills the display with the text start again, done when scrolling is
+ * enabled so text appended meanwhile is included. Stream only mode skips
+ * the strip and starts blank, streamed text enters from the right edge.
+ */
+static void scrollRewind( T_c7x10y_ctx *ctx )
+{
+    uint8_t col;
+
+    _memset( (uint8_t*)ctx->view, 0, sizeof( ctx->view ) );
+    ctx->viewOffset    = 0;
+    ctx->scrollRestart = false;
+    ctx->textCol       = 0;
+    ctx->scrollLeft    = ctx->panels * 10 + C7X10Y_PITCH;
+#if C7X10Y_STREAM_SIZE > 0
+    ctx->streamPrev    = ctx->textLast;
+    ctx->glyphPos      = 0;
+    ctx->glyphLen      = 0;
+
+    if (ctx->streamOnly)
+    {
+        ctx->textCol    = ctx->stripLength;
+        ctx->streamPrev = ' ';
+        return;
+    }
+#endif
+
+    for (col = 0; col < ctx->panels * 10; col++)
+    {
+        scrollShift( ctx );
+    }
+}
+
+/*
+ * Scrolls the text one column, frame buffer is not touched. Called at the
+ * frame start only, so the frame is never displayed half scrolled. Scroll
+ * may run from the scan interrupt, so the frame with the text layer is
+ * only requested at the scroll end and composited on the main side.
+ */
+static void scrollStep( T_c7x10y_ctx *ctx )
+{
+    scrollShift( ctx );
+
+#if C7X10Y_STREAM_SIZE > 0
+    if (ctx->streamOnly)
+    {
+        return;
+    }
+#endif
+
+    if (0 == ctx->scrollLeft)
+    {
+        ctx->scrollRestart = true;
+        ctx->scroll = false;
+#if C7X10Y_COMPOSE
+        ctx->composeReq = true;
+#endif
+    }
+}
+
+/* --------------------------------------------------------- PUBLIC FUNCTIONS */
+
+#ifdef   __C7X10Y_DRV_SPI__
+
+void c7x10y_init( T_c7x10y_ctx *ctx, T_C7X10Y_P gpioObj, T_C7X10Y_P spiObj )
+{
+    T_c7x10y_ctx *tmp = ctxList;
+#if C7X10Y_SPRITES_MAX > 0
+    uint8_t idx;
+#endif
+
+    while (0 != tmp && ctx != tmp)
+    {
+        tmp = tmp->next;
+    }
+
+    if (0 == tmp)
+    {
+        _memset( (uint8_t*)ctx, 0, sizeof( T_c7x10y_ctx ) );
+        ctx->next = ctxList;
+        ctxList   = ctx;
+    }
+
+    ctx->panelGpio[0] = gpioObj;
+    ctx->panels       = 1;
+    ctx->spiObj       = spiObj;
+#if C7X10Y_COMPOSE
+    ctx->frame        = &ctx->layerBuf[0];
+    _memset( ctx->layerMode, C7X10Y_BLEND_OR, C7X10Y_LAYERS );
+#else
+    ctx->frame        = &ctx->frameBuf[0];
+#endif
+    ctx->scanFrame    = &ctx->frameBuf[0];
+    ctx->brightGain   = 255;
+    ctx->targetPeriod = 7000;
+    c7x10y_setTiming( ctx, &_C7X10Y_TIMING_SAFE );
+    c7x10y_setOrientation( ctx, _C7X10Y_ORIENT_NORMAL );
+    c7x10y_setClip( ctx, 1, 1, 10, 7 );
+#if C7X10Y_BUILTIN_FONT
+    ctx->textFont     = &_C7X10Y_FONT_FIXED;
+#else
+    ctx->textFont     = 0;
+#endif
+    ctx->stripLength  = 0;
+    ctx->textLast     = 0;
+    ctx->scrollRestart = true;
+#if C7X10Y_STREAM_SIZE > 0
+    ctx->glyphPos     = 0;
+    ctx->glyphLen     = 0;
+    ctx->streamOnly   = false;
+#endif
+
+#if C7X10Y_SPRITES_MAX > 0
+    for (idx = 0; idx < C7X10Y_SPRITES_MAX; idx++)
+    {
+        ctx->spriteOrder[ idx ] = idx;
+    }
+#endif
+
+    busWait();
+    boundCtx = 0;
+    bind( ctx, 0 );
+    moduleReset( ctx );
+    blank( ctx );
+    ctx->rowCounter = C7X10Y_ROW_UNKNOWN;
+}
+
+void c7x10y_addPanel( T_c7x10y_ctx *ctx, T_C7X10Y_P gpioObj )
+{
+    if (C7X10Y_PANELS_MAX <= ctx->panels)
+    {
+        return;
+    }
+
+    ctx->panelGpio[ ctx->panels ] = gpioObj;
+    busWait();
+    bind( ctx, ctx->panels );
+    moduleReset( ctx );
+    blank( ctx );
+    ctx->panels++;
+    ctx->rowCounter = C7X10Y_ROW_UNKNOWN;
+    c7x10y_setOrientation( ctx, ctx->orientation );
+    c7x10y_setClip( ctx, 1, 1, ctx->panels * 10, 7 );
+    ctx->scrollRestart = true;
+}
+
+#endif
+#ifdef   __C7X10Y_DRV_I2C__
+
+void c7x10y_i2cDriverInit(T_C7X10Y_P gpioObj, T_C7X10Y_P i2cObj, uint8_t slave)
+{
+    _slaveAddress = slave;
+    hal_i2cMap( (T_HAL_P)i2cObj );
+    hal_gpioMap( (T_HAL_P)gpioObj );
+
+    // ... power ON
+    // ... configure CHIP
+}
+
+#endif
+#ifdef   __C7X10Y_DRV_UART__
+
+void c7x10y_uartDriverInit(T_C7X10Y_P gpioObj, T_C7X10Y_P uartObj)
+{
+    hal_uartMap( (T_HAL_P)uartObj );
+    hal_gpioMap( (T_HAL_P)gpioObj );
+
+    // ... power ON
+    // ... configure CHIP
+}
+
+#endif
+
+/* ----------------------------------------------------------- IMPLEMENTATION */
+
+bool c7x10y_refreshDisplay( T_c7x10y_ctx *ctx )
+{
+    bool scrolled = ctx->scroll;
+
+    scrollUpdate( ctx );
+#if C7X10Y_COMPOSE
+    if (ctx->composeReq)
+    {
+        compose( ctx );
+    }
+#endif
+    drawFrame( ctx );
+
+    return scrolled ? ctx->scroll : true;
+}
+
+uint16_t c7x10y_scanStep()
+{
+    T_c7x10y_ctx *ctx;
+    uint16_t next = 0xFFFF;
+
+    for (ctx = ctxList; 0 != ctx; ctx = ctx->next)
+    {
+        if (ctx->scanWait > scanElapsed)
+        {
+            ctx->scanWait -= scanElapsed;
+        }
+        else
+        {
+            if (0 == ctx->scanRowIdx)
+            {
+                scrollUpdate( ctx );
+            }
+
+            ctx->scanWait = scanRow( ctx );
+        }
+
+        if (next > ctx->scanWait)
+        {
+            next = ctx->scanWait;
+        }
+    }
+
+    scanElapsed = next;
+
+    return next;
+}
+
+void c7x10y_setRefreshHz( T_c7x10y_ctx *ctx, uint16_t hz )
+{
+    uint32_t dwell;
+
+    if (0 == hz)
+    {
+        return;
+    }
+
+    ctx->targetPeriod = 1000000UL / hz;
+    dwell = ctx->targetPeriod / 7;
+
+    ctx->timing.rowDwell = ( 0xFFFF < dwell ) ? 0xFFFF : (uint16_t)dwell;
+}
+
+void c7x10y_setClock( T_c7x10y_ctx *ctx, T_c7x10y_clockFp clock )
+{
+    ctx->govRun      = false;
+    ctx->framePeriod = 0;
+    ctx->scanTime    = 0;
+    ctx->clockFp     = clock;
+}
+
+uint16_t c7x10y_getRefreshHz( T_c7x10y_ctx *ctx )
+{
+    if (0 == ctx->framePeriod)
+    {
+        return 0;
+    }
+
+    return (uint16_t)( 1000000UL / ctx->framePeriod );
+}
+
+void c7x10y_setBrightness( T_c7x10y_ctx *ctx, uint8_t level )
+{
+    if (C7X10Y_BRIGHTNESS_MAX < level)
+    {
+        level = C7X10Y_BRIGHTNESS_MAX;
+    }
+
+    ctx->brightGain = gammaTable[ level ];
+}
+
+void c7x10y_setResync( T_c7x10y_ctx *ctx, uint16_t frames )
+{
+    ctx->resyncFrames = frames;
+    ctx->resyncCount  = 0;
+}
+
+void c7x10y_resync( T_c7x10y_ctx *ctx )
+{
+    ctx->resyncReq = true;
+}
+
+void c7x10y_setTiming( T_c7x10y_ctx *ctx, const T_c7x10y_timing *timing )
+{
+    ctx->timing.latchPulse = timing->latchPulse;
+    ctx->timing.rowDwell   = timing->rowDwell;
+    ctx->timing.blankGap   = timing->blankGap;
+    ctx->timing.resetPulse = timing->resetPulse;
+}
+
+void c7x10y_setOrientation( T_c7x10y_ctx *ctx, uint8_t orientation )
+{
+    uint8_t idx;
+
+    ctx->orientation = orientation;
+
+    for (idx = 0; idx < 7; idx++)
+    {
+        ctx->rowMap[ idx ] = ( orientation & C7X10Y_ORIENT_FLIP_V ) ? 6 - idx : idx;
+    }
+
+    for (idx = 0; idx < ctx->panels; idx++)
+    {
+        ctx->panelMap[ idx ] = ( orientation & C7X10Y_ORIENT_FLIP_H ) ? ctx->panels - 1 - idx : idx;
+    }
+
+    if (orientation & C7X10Y_ORIENT_FLIP_H)
+    {
+        ctx->colMap        = colOrder[ 1 ];
+        ctx->colShift[ 0 ] = 0;
+        ctx->colShift[ 1 ] = 5;
+    }
+    else
+    {
+        ctx->colMap        = colOrder[ 0 ];
+        ctx->colShift[ 0 ] = 5;
+        ctx->colShift[ 1 ] = 0;
+    }
+}
+
+#ifdef __MIKROC_PRO_FOR_ARM__
+
+bool c7x10y_setSpiDma( T_c7x10y_spiDmaFp dmaStart )
+{
+    if (spiBusy || 0 != hal_spiDmaMap( (T_hal_spiDmaFp)dmaStart ))
+    {
+        return false;
+    }
+
+    spiChain = ( 0 != dmaStart );
+
+    return true;
+}
+
+void c7x10y_spiDmaDone()
+{
+    hal_spiAsyncDone();
+}
+
+#endif
+
+void c7x10y_doubleBuffer( T_c7x10y_ctx *ctx, bool enable )
+{
+#if C7X10Y_COMPOSE
+    (void)ctx;
+    (void)enable;
+#else
+    ctx->presentReq = false;
+
+    if (enable)
+    {
+        ctx->frame  = ( ctx->scanFrame == &ctx->frameBuf[0] ) ? &ctx->frameBuf[1] : &ctx->frameBuf[0];
+        *ctx->frame = *ctx->scanFrame;
+    }
+    else
+    {
+        ctx->frame = ctx->scanFrame;
+    }
+#endif
+}
+
+bool c7x10y_present( T_c7x10y_ctx *ctx )
+{
+#if C7X10Y_COMPOSE
+    return compose( ctx );
+#else
+    if (ctx->frame != ctx->scanFrame)
+    {
+        ctx->presentReq = true;
+    }
+
+    return true;
+#endif
+}
+
+#if C7X10Y_COMPOSE
+
+void c7x10y_selectLayer( T_c7x10y_ctx *ctx, uint8_t layer )
+{
+    if (C7X10Y_LAYERS > layer)
+    {
+        ctx->frame = &ctx->layerBuf[ layer ];
+        ctx->layer = layer;
+    }
+}
+
+void c7x10y_setLayerMode( T_c7x10y_ctx *ctx, uint8_t layer, uint8_t mode )
+{
+    if (C7X10Y_LAYERS > layer)
+    {
+        ctx->layerMode[ layer ] = mode;
+    }
+}
+
+#endif
+
+bool c7x10y_presentPending( T_c7x10y_ctx *ctx )
+{
+    return ctx->presentReq;
+}
+
+bool c7x10y_scrollActive( T_c7x10y_ctx *ctx )
+{
+#if C7X10Y_COMPOSE
+    if (!ctx->scroll && ctx->composeReq)
+    {
+        compose( ctx );
+    }
+#endif
+    return ctx->scroll;
+}
+
+void c7x10y_clearDisplay( T_c7x10y_ctx *ctx )
+{
+    _memset( (uint8_t*)ctx->frame, 0, sizeof( T_c7x10y_frame ) );
+}
+
+void c7x10y_drawPixel( T_c7x10y_ctx *ctx, uint8_t row, uint8_t col )
+{
+    if (row > 7 || col > ctx->panels * 10 || row == 0 || col == 0)
+    {
+        return;
+    }
+
+    ctx->frame->px[ row - 1 ][ ( col - 1 ) / 10 ] |= 0x0001 << ( ( col - 1 ) % 10 );
+}
+
+void c7x10y_clearPixel( T_c7x10y_ctx *ctx, uint8_t row, uint8_t col )
+{
+    uint8_t pixel[2];
+
+    pixel[ 0 ] = row;
+    pixel[ 1 ] = col;
+    pixelBatch( ctx, pixel, 1, C7X10Y_BLIT_CLEAR );
+}
+
+void c7x10y_togglePixel( T_c7x10y_ctx *ctx, uint8_t row, uint8_t col )
+{
+    uint8_t pixel[2];
+
+    pixel[ 0 ] = row;
+    pixel[ 1 ] = col;
+    pixelBatch( ctx, pixel, 1, C7X10Y_BLIT_XOR );
+}
+
+bool c7x10y_getPixel( T_c7x10y_ctx *ctx, uint8_t row, uint8_t col )
+{
+    row--;
+    col--;
+
+    if (7 <= row || ctx->panels * 10 <= col)
+    {
+        return false;
+    }
+
+    return ( 0 != ( pixelWord( ctx->frame, row, col / 10 ) & ( 0x0001 << ( col % 10 ) ) ) );
+}
+
+void c7x10y_drawPixels( T_c7x10y_ctx *ctx, const uint8_t *pixels, uint8_t count )
+{
+    pixelBatch( ctx, pixels, count, C7X10Y_BLIT_SET );
+}
+
+void c7x10y_clearPixels( T_c7x10y_ctx *ctx, const uint8_t *pixels, uint8_t count )
+{
+    pixelBatch( ctx, pixels, count, C7X10Y_BLIT_CLEAR );
+}
+
+void c7x10y_togglePixels( T_c7x10y_ctx *ctx, const uint8_t *pixels, uint8_t count )
+{
+    pixelBatch( ctx, pixels, count, C7X10Y_BLIT_XOR );
+}
+
+void c7x10y_getPixels( T_c7x10y_ctx *ctx, const uint8_t *pixels, uint8_t count, bool *states )
+{
+    T_c7x10y_frame *frame = ctx->frame;
+    uint8_t width = ctx->panels * 10;
+    uint8_t row;
+    uint8_t col;
+
+    while (0 != count--)
+    {
+        row = *pixels++ - 1;
+        col = *pixels++ - 1;
+
+        if (7 <= row || width <= col)
+        {
+            *states++ = false;
+        }
+        else
+        {
+            *states++ = ( 0 != ( pixelWord( frame, row, col / 10 ) & ( 0x0001 << ( col % 10 ) ) ) );
+        }
+    }
+}
+
+void c7x10y_drawPixelLevel( T_c7x10y_ctx *ctx, uint8_t row, uint8_t col, uint8_t level )
+{
+    T_c7x10y_frame *frame = ctx->frame;
+    uint8_t panel;
+    uint16_t mask;
+
+    if (row > 7 || col > ctx->panels * 10 || row == 0 || col == 0)
+    {
+        return;
+    }
+
+    panel = ( col - 1 ) / 10;
+    mask  = 0x0001 << ( ( col - 1 ) % 10 );
+
+#if C7X10Y_GRAY_BITS > 1
+    {
+        uint8_t plane;
+
+        frame->px[ row - 1 ][ panel ] &= ~mask;
+
+        for (plane = 0; plane < C7X10Y_GRAY_BITS; plane++)
+        {
+            if (level & ( 0x01 << plane ))
+            {
+                frame->gray[ plane ][ row - 1 ][ panel ] |= mask;
+            }
+            else
+            {
+                frame->gray[ plane ][ row - 1 ][ panel ] &= ~mask;
+            }
+        }
+    }
+#else
+    if (0 != level)
+    {
+        frame->px[ row - 1 ][ panel ] |= mask;
+    }
+    else
+    {
+        frame->px[ row - 1 ][ panel ] &= ~mask;
+    }
+#endif
+}
+
+void c7x10y_setClip( T_c7x10y_ctx *ctx, uint8_t col, uint8_t row, uint8_t w, uint8_t h )
+{
+    uint8_t panel;
+    uint8_t bit;
+    uint16_t first;
+    uint16_t last = (uint16_t)row + h - 1;
+
+    /* Rectangle is cut to the display, empty one skips all rows */
+    if (0 == h || 0 == last)
+    {
+        ctx->clipTop    = 7;
+        ctx->clipBottom = 0;
+    }
+    else
+    {
+        ctx->clipTop    = ( 0 == row ) ? 0 : row - 1;
+        ctx->clipBottom = ( 7 < last ) ? 6 : last - 1;
+    }
+
+    for (panel = 0; panel < ctx->panels; panel++)
+    {
+        ctx->clipMask[ panel ] = 0;
+        first = panel * 10 + 1;
+
+        for (bit = 0; bit < 10; bit++)
+        {
+            if (first + bit >= col && first + bit < col + w)
+            {
+                ctx->clipMask[ panel ] |= 0x0001 << bit;
+            }
+        }
+    }
+}
+
+void c7x10y_blit( T_c7x10y_ctx *ctx, const uint8_t *bitmap, uint8_t w, uint8_t h, int16_t col, int16_t row, uint8_t op )
+{
+    blitTo( ctx, ctx->frame, bitmap, w, h, col, row, op, true );
+}
+
+void c7x10y_drawImage( T_c7x10y_ctx *ctx, const uint16_t *image, uint8_t panels )
+{
+    uint8_t row;
+    uint8_t panel;
+
+    for (row = 0; row < 7; row++, image += panels)
+    {
+        for (panel = 0; panel < ctx->panels; panel++)
+        {
+#if C7X10Y_GRAY_BITS > 1
+            grayFlatten( ctx->frame, row, panel, 0x03FF );
+#endif
+            ctx->frame->px[ row ][ panel ] = ( panel < panels ) ? image[ panel ] & 0x03FF : 0;
+        }
+    }
+}
+
+void c7x10y_drawLine( T_c7x10y_ctx *ctx, int16_t col0, int16_t row0, int16_t col1, int16_t row1 )
+{
+    int16_t dx = ( col1 > col0 ) ? col1 - col0 : col0 - col1;
+    int16_t dy = ( row1 > row0 ) ? row0 - row1 : row1 - row0;
+    int16_t sx = ( col1 > col0 ) ? 1 : -1;
+    int16_t sy = ( row1 > row0 ) ? 1 : -1;
+    int16_t err = dx + dy;
+    int16_t err2;
+
+    if (row0 == row1)
+    {
+        span( ctx, row0 - 1, ( 0 < sx ? col0 : col1 ) - 1, ( 0 < sx ? col1 : col0 ) - 1, C7X10Y_BLIT_SET );
+        return;
+    }
+
+    for (;;)
+    {
+        span( ctx, row0 - 1, col0 - 1, col0 - 1, C7X10Y_BLIT_SET );
+
+        if (col0 == col1 && row0 == row1)
+        {
+            break;
+        }
+
+        err2 = err * 2;
+
+        if (err2 >= dy)
+        {
+            err  += dy;
+            col0 += sx;
+        }
+
+        if (err2 <= dx)
+        {
+            err  += dx;
+            row0 += sy;
+        }
+    }
+}
+
+void c7x10y_drawRect( T_c7x10y_ctx *ctx, int16_t col, int16_t row, uint8_t w, uint8_t h )
+{
+    int16_t dst;
+
+    if (0 == w || 0 == h)
+    {
+        return;
+    }
+
+    span( ctx, row - 1, col - 1, col + w - 2, C7X10Y_BLIT_SET );
+    span( ctx, row + h - 2, col - 1, col + w - 2, C7X10Y_BLIT_SET );
+
+    for (dst = row; dst < row + h - 2; dst++)
+    {
+        span( ctx, dst, col - 1, col - 1, C7X10Y_BLIT_SET );
+        span( ctx, dst, col + w - 2, col + w - 2, C7X10Y_BLIT_SET );
+    }
+}
+
+void c7x10y_fillRect( T_c7x10y_ctx *ctx, int16_t col, int16_t row, uint8_t w, uint8_t h, uint8_t op )
+{
+    int16_t dst;
+
+    if (0 == w)
+    {
+        return;
+    }
+
+    for (dst = row - 1; dst < row - 1 + h; dst++)
+    {
+        span( ctx, dst, col - 1, col + w - 2, op );
+    }
+}
+
+void c7x10y_drawCircle( T_c7x10y_ctx *ctx, int16_t col, int16_t row, uint8_t radius )
+{
+    int16_t x = radius;
+    int16_t y = 0;
+    int16_t err = 1 - x;
+
+    col--;
+    row--;
+
+    while (x >= y)
+    {
+        span( ctx, row + y, col - x, col - x, C7X10Y_BLIT_SET );
+        span( ctx, row + y, col + x, col + x, C7X10Y_BLIT_SET );
+        span( ctx, row - y, col - x, col - x, C7X10Y_BLIT_SET );
+        span( ctx, row - y, col + x, col + x, C7X10Y_BLIT_SET );
+        span( ctx, row + x, col - y, col - y, C7X10Y_BLIT_SET );
+        span( ctx, row + x, col + y, col + y, C7X10Y_BLIT_SET );
+        span( ctx, row - x, col - y, col - y, C7X10Y_BLIT_SET );
+        span( ctx, row - x, col + y, col + y, C7X10Y_BLIT_SET );
+
+        y++;
+
+        if (0 > err)
+        {
+            err += 2 * y + 1;
+        }
+        else
+        {
+            x--;
+            err += 2 * ( y - x ) + 1;
+        }
+    }
+}
+
+void c7x10y_floodFill( T_c7x10y_ctx *ctx, uint8_t col, uint8_t row )
+{
+    T_c7x10y_frame *frame = ctx->frame;
+    uint16_t fill[7][ C7X10Y_PANELS_MAX ];
+    uint16_t grow;
+    uint8_t panel;
+    bool more = true;
+
+    row--;
+    col--;
+
+    if (7 <= row || ctx->panels * 10 <= col || ( pixelWord( frame, row, col / 10 ) & ( 0x0001 << ( col % 10 ) ) ))
+    {
+        return;
+    }
+
+    _memset( (uint8_t*)fill, 0, sizeof( fill ) );
+    fill[ row ][ col / 10 ] = 0x0001 << ( col % 10 );
+
+    /* Grows the filled area by one pixel in all directions, a row word at
+       a time, until it is stopped by lit pixels. */
+    while (more)
+    {
+        more = false;
+
+        for (row = 0; row < 7; row++)
+        {
+            for (panel = 0; panel < ctx->panels; panel++)
+            {
+                grow = fill[ row ][ panel ];
+                grow |= ( grow << 1 ) | ( grow >> 1 );
+
+                if (0 < panel)
+                {
+                    grow |= fill[ row ][ panel - 1 ] >> 9;
+                }
+
+                if (ctx->panels > panel + 1)
+                {
+                    grow |= ( fill[ row ][ panel + 1 ] & 0x0001 ) << 9;
+                }
+
+                if (0 < row)
+                {
+                    grow |= fill[ row - 1 ][ panel ];
+                }
+
+                if (6 > row)
+                {
+                    grow |= fill[ row + 1 ][ panel ];
+                }
+
+                grow &= ~pixelWord( frame, row, panel ) & 0x03FF;
+
+                if (grow != fill[ row ][ panel ])
+                {
+                    fill[ row ][ panel ] = grow;
+                    more = true;
+                }
+            }
+        }
+    }
+
+    for (row = 0; row < 7; row++)
+    {
+        for (panel = 0; panel < ctx->panels; panel++)
+        {
+            frame->px[ row ][ panel ] |= fill[ row ][ panel ];
+        }
+    }
+}
+
+uint16_t c7x10y_fontIndex( const T_c7x10y_font *fnt, uint8_t ch )
+{
+    const T_c7x10y_range *range = fnt->ranges;
+    uint8_t count;
+
+    for (count = fnt->rangeCount; 0 != count; count--, range++)
+    {
+        if (ch >= range->first && ch <= range->last)
+        {
+            return range->glyph + ( ch - range->first );
+        }
+    }
+
+    return fnt->defaultGlyph;
+}
+
+const uint8_t *c7x10y_fontGlyph( const T_c7x10y_font *fnt, uint8_t ch )
+{
+    return &fnt->glyphs[ c7x10y_fontIndex( fnt, ch ) * 5 ];
+}
+
+uint8_t c7x10y_fontWidth( const T_c7x10y_font *fnt, uint8_t ch )
+{
+    if (0 == fnt->metrics)
+    {
+        return 5;
+    }
+
+    return fnt->metrics[ c7x10y_fontIndex( fnt, ch ) ] & 0x0F;
+}
+
+void c7x10y_setFont( T_c7x10y_ctx *ctx, const T_c7x10y_font *fnt )
+{
+    ctx->textFont = fnt;
+}
+
+uint16_t c7x10y_textWidth( T_c7x10y_ctx *ctx, char *txt )
+{
+    uint16_t width = 0;
+    uint8_t prev = 0;
+    uint8_t ch;
+
+    if (0 == ctx->textFont)
+    {
+        return 0;
+    }
+
+    while (0 != *txt)
+    {
+        ch     = *txt++;
+        width += glyphGap( ctx->textFont, prev, ch ) + c7x10y_fontWidth( ctx->textFont, ch );
+        prev   = ch;
+    }
+
+    return width;
+}
+
+void c7x10y_drawText( T_c7x10y_ctx *ctx, char* txt )
+{
+    uint8_t *pStrip = ctx->strip;
+    uint8_t length = _strlen( txt );
+    uint8_t prev = 0;
+    uint8_t gap;
+    uint8_t ch;
+    uint8_t bits;
+    uint16_t col;
+    uint8_t i;
+
+    if (0 == ctx->textFont)
+    {
+        return;
+    }
+
+    if (C7X10Y_TEXT_MAX < length)
+    {
+        length = C7X10Y_TEXT_MAX;
+    }
+
+    while (0 != length--)
+    {
+        ch  = *txt++;
+        gap = glyphGap( ctx->textFont, prev, ch );
+        _memset( pStrip, 0, gap );
+        pStrip += gap;
+        pStrip += glyphColumns( ctx->textFont, ch, pStrip );
+        prev    = ch;
+    }
+
+    ctx->stripLength = pStrip - ctx->strip;
+    ctx->textLast    = prev;
+
+    _memset( (uint8_t*)ctx->frame, 0, sizeof( T_c7x10y_frame ) );
+
+    for (col = 0; col < ctx->panels * 10 && col < ctx->stripLength; col++)
+    {
+        bits = ctx->strip[ col ];
+
+        for (i = 0; i < 7; i++)
+        {
+            ctx->frame->px[i][ col / 10 ] |= (uint16_t)( ( bits >> i ) & 0x01 ) << ( col % 10 );
+        }
+    }
+
+    ctx->scrollRestart = true;
+}
+
+
+void c7x10y_drawNumber( T_c7x10y_ctx *ctx, uint8_t num )
+{
+    if (99 < num || 0 == ctx->textFont)
+    {
+        return;
+    }
+
+    if (10 <= num)
+    {
+        numberDigit( ctx, num / 10, 0 );
+    }
+
+    numberDigit( ctx, num % 10, 5 );
+}
+
+void c7x10y_scrollEnable( T_c7x10y_ctx *ctx, uint8_t speed )
+{
+    if (ctx->scrollRestart)
+    {
+        scrollRewind( ctx );
+    }
+
+    ctx->scroll = true;
+    ctx->scrollSpeed = speed;
+    ctx->timerTick = 0;
+#if C7X10Y_COMPOSE
+    ctx->textLayer = ctx->layer;
+    compose( ctx );
+#endif
+}
+
+#if C7X10Y_STREAM_SIZE > 0
+
+uint8_t c7x10y_textAppend( T_c7x10y_ctx *ctx, char *chars, uint8_t n )
+{
+    uint8_t head = ctx->streamHead;
+    uint8_t count = 0;
+
+    while (count < n && C7X10Y_STREAM_SIZE > (uint8_t)( head - ctx->streamTail ))
+    {
+        ctx->stream[ head & ( C7X10Y_STREAM_SIZE - 1 ) ] = chars[ count++ ];
+        head++;
+    }
+
+    ctx->streamHead = head;
+
+    return count;
+}
+
+void c7x10y_streamMode( T_c7x10y_ctx *ctx, bool only )
+{
+    ctx->streamOnly    = only;
+    ctx->scrollRestart = true;
+}
+
+#endif
+
+void c7x10y_scrollDisable( T_c7x10y_ctx *ctx )
+{
+    ctx->scroll = false;
+#if C7X10Y_COMPOSE
+    compose( ctx );
+#endif
+}
+
+void c7x10y_tick( T_c7x10y_ctx *ctx )
+{
+#if C7X10Y_SPRITES_MAX > 0
+    T_c7x10y_sprite *spr = &ctx->sprite[0];
+    uint8_t idx;
+
+    for (idx = 0; idx < C7X10Y_SPRITES_MAX; idx++, spr++)
+    {
+        // Sprite being moved by the main side keeps its position this tick
+        if (spr->visible && idx + 1 != ctx->spriteBusy)
+        {
+            spr->x += spr->vx;
+            spr->y += spr->vy;
+        }
+    }
+    ctx->spriteSeq++;
+#endif
+    ctx->timerTick++;
+}
+
+#if C7X10Y_SPRITES_MAX > 0
+
+void c7x10y_spriteSet( T_c7x10y_ctx *ctx, uint8_t id, const uint8_t *bitmap, uint8_t w, uint8_t h )
+{
+    if (C7X10Y_SPRITES_MAX <= id)
+    {
+        return;
+    }
+
+    ctx->sprite[ id ].bitmap = bitmap;
+    ctx->sprite[ id ].w      = w;
+    ctx->sprite[ id ].h      = h;
+}
+
+void c7x10y_spriteMove( T_c7x10y_ctx *ctx, uint8_t id, int16_t col, int16_t row )
+{
+    if (C7X10Y_SPRITES_MAX <= id)
+    {
+        return;
+    }
+
+    ctx->spriteBusy     = id + 1;
+    ctx->sprite[ id ].x = (int32_t)( col - 1 ) << 8;
+    ctx->sprite[ id ].y = (int32_t)( row - 1 ) << 8;
+    ctx->spriteBusy     = 0;
+}
+
+void c7x10y_spriteSpeed( T_c7x10y_ctx *ctx, uint8_t id, int16_t vx, int16_t vy )
+{
+    if (C7X10Y_SPRITES_MAX <= id)
+    {
+        return;
+    }
+
+    ctx->spriteBusy      = id + 1;
+    ctx->sprite[ id ].vx = vx;
+    ctx->sprite[ id ].vy = vy;
+    ctx->spriteBusy      = 0;
+}
+
+void c7x10y_spriteZ( T_c7x10y_ctx *ctx, uint8_t id, uint8_t z )
+{
+    uint8_t i, j, tmp;
+
+    if (C7X10Y_SPRITES_MAX <= id)
+    {
+        return;
+    }
+
+    ctx->sprite[ id ].z = z;
+
+    // Insertion sort, drawing order changes rarely
+    for (i = 1; i < C7X10Y_SPRITES_MAX; i++)
+    {
+        tmp = ctx->spriteOrder[ i ];
+
+        for (j = i; j > 0 && ctx->sprite[ ctx->spriteOrder[ j - 1 ] ].z > ctx->sprite[ tmp ].z; j--)
+        {
+            ctx->spriteOrder[ j ] = ctx->spriteOrder[ j - 1 ];
+        }
+
+        ctx->spriteOrder[ j ] = tmp;
+    }
+}
+
+void c7x10y_spriteShow( T_c7x10y_ctx *ctx, uint8_t id, bool visible )
+{
+    if (C7X10Y_SPRITES_MAX <= id)
+    {
+        return;
+    }
+
+    ctx->sprite[ id ].visible = visible;
+}
+
+int16_t c7x10y_spriteCol( T_c7x10y_ctx *ctx, uint8_t id )
+{
+    int16_t col[ C7X10Y_SPRITES_MAX ];
+    int16_t row[ C7X10Y_SPRITES_MAX ];
+
+    if (C7X10Y_SPRITES_MAX <= id)
+    {
+        return 0;
+    }
+
+    spriteSnap( ctx, col, row );
+
+    return col[ id ];
+}
+
+int16_t c7x10y_spriteRow( T_c7x10y_ctx *ctx, uint8_t id )
+{
+    int16_t col[ C7X10Y_SPRITES_MAX ];
+    int16_t row[ C7X10Y_SPRITES_MAX ];
+
+    if (C7X10Y_SPRITES_MAX <= id)
+    {
+        return 0;
+    }
+
+    spriteSnap( ctx, col, row );
+
+    return row[ id ];
+}
+
+bool c7x10y_spriteHit( T_c7x10y_ctx *ctx, uint8_t a, uint8_t b )
+{
+    T_c7x10y_sprite *sa;
+    T_c7x10y_sprite *sb;
+    int16_t col[ C7X10Y_SPRITES_MAX ];
+    int16_t pos[ C7X10Y_SPRITES_MAX ];
+    int32_t rowA;
+    int32_t rowB;
+    int32_t diff;
+    int32_t row;
+    int32_t bottom;
+    uint32_t bitsA;
+    uint32_t bitsB;
+
+    if (C7X10Y_SPRITES_MAX <= a || C7X10Y_SPRITES_MAX <= b)
+    {
+        return false;
+    }
+
+    spriteSnap( ctx, col, pos );
+    sa   = &ctx->sprite[ a ];
+    sb   = &ctx->sprite[ b ];
+    rowA = pos[ a ];
+    rowB = pos[ b ];
+    diff = (int32_t)col[ b ] - col[ a ];
+
+    if (!sa->visible || !sb->visible || 16 <= diff || -16 >= diff)
+    {
+        return false;
+    }
+
+    row    = ( rowA > rowB ) ? rowA : rowB;
+    bottom = ( rowA + sa->h < rowB + sb->h ) ? rowA + sa->h : rowB + sb->h;
+
+    for (; row < bottom; row++)
+    {
+        bitsA = bitmapRow( &sa->bitmap[ ( row - rowA ) * ( ( sa->w + 7 ) >> 3 ) ], sa->w );
+        bitsB = bitmapRow( &sb->bitmap[ ( row - rowB ) * ( ( sb->w + 7 ) >> 3 ) ], sb->w );
+
+        if (0 <= diff)
+        {
+            bitsB <<= diff;
+        }
+        else
+        {
+            bitsA <<= -diff;
+        }
+
+        if (0 != ( bitsA & bitsB ))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool c7x10y_spriteHitBg( T_c7x10y_ctx *ctx, uint8_t id )
+{
+    T_c7x10y_sprite *spr;
+    T_c7x10y_frame *bg = &ctx->layerBuf[0];
+    int16_t cols[ C7X10Y_SPRITES_MAX ];
+    int16_t rows[ C7X10Y_SPRITES_MAX ];
+    int16_t top;
+    int16_t col;
+    int16_t row;
+    uint16_t bits;
+    uint8_t panel;
+
+    if (C7X10Y_SPRITES_MAX <= id)
+    {
+        return false;
+    }
+
+    spriteSnap( ctx, cols, rows );
+    spr = &ctx->sprite[ id ];
+    top = rows[ id ] - 1;
+    col = cols[ id ] - 1;
+
+    if (!spr->visible || 6 < top)
+    {
+        return false;
+    }
+
+    for (row = ( 0 > top ) ? 0 : top; row < top + spr->h && row < 7; row++)
+    {
+        bits = bitmapRow( &spr->bitmap[ ( row - top ) * ( ( spr->w + 7 ) >> 3 ) ], spr->w );
+
+        for (panel = 0; panel < ctx->panels; panel++)
+        {
+            if (0 != ( placeRow( bits, col - panel * 10 ) & pixelWord( bg, row, panel ) ))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+#endif
 
 /* -------------------------------------------------------------------------- */
 /*
@@ -77,6 +77,68 @@
 //  #define   __C7X10Y_DRV_I2C__                                            
 // #define   __C7X10Y_DRV_UART__  
 
+/**
+ * Grayscale depth in bits per pixel - 1 is monochrome, 2 to 4 enables
+ * grayscale bit planes (each plane takes additional 14 bytes of RAM per
+ * frame buffer).
+ */
+#define   C7X10Y_GRAY_BITS          1
+
+/**
+ * Maximum number of panels (click boards) tiled into one display, up to 16.
+ * Each panel takes 14 bytes of RAM per frame buffer and bit plane.
+ */
+#define   C7X10Y_PANELS_MAX         1
+
+/**
+ * Maximum text length, text is rendered at once into a strip of one byte
+ * per column, so each character takes 5 bytes of RAM and one per gap
+ * column.
+ */
+#define   C7X10Y_TEXT_MAX           40
+
+/**
+ * Blank columns between two characters of text, kerning pairs of the font
+ * can narrow it. Default 0 keeps the 5 column pitch of the previous driver
+ * versions, so two characters fit one panel - proportional font and
+ * scrolled text read better with 1.
+ */
+#define   C7X10Y_CHAR_GAP           0
+
+/**
+ * Number of drawing layers - 1 draws directly to the frame buffer, 3 gives
+ * background, content and overlay layer composited by ```c7x10y_present```
+ * (each layer takes one frame buffer of RAM).
+ */
+#define   C7X10Y_LAYERS             1
+
+/**
+ * Size of the sprite table, 0 disables sprites. Sprites are drawn over the
+ * layers by ```c7x10y_present```.
+ */
+#define   C7X10Y_SPRITES_MAX        0
+
+/**
+ * Size of the streamed text ring (power of two, up to 128), 0 disables
+ * ```c7x10y_textAppend```. Streamed text length is not limited, RAM use
+ * does not depend on it.
+ */
+#define   C7X10Y_STREAM_SIZE        0
+
+#if C7X10Y_STREAM_SIZE & ( C7X10Y_STREAM_SIZE - 1 )
+#error C7X10Y_STREAM_SIZE must be a power of two
+#endif
+
+/**
+ * 1 builds in the 5x7 font of ```7x5font.h```, selected at init. 0 leaves it
+ * out to save program memory, text and numbers are then drawn only after an
+ * application font is set by ```c7x10y_setFont```.
+ */
+#define   C7X10Y_BUILTIN_FONT       1
+
+/* Layers or sprites - drawing buffers are composited into scan buffers */
+#define   C7X10Y_COMPOSE            ( 1 < C7X10Y_LAYERS || 0 < C7X10Y_SPRITES_MAX )
+
 #define T_C7X10Y_P    const uint8_t*
 
 /** @section                                 C7x10Y_VAR Driver Variables
@@ -86,14 +148,258 @@ extern const uint8_t _C7X10Y_SPEED_SLOW;
 extern const uint8_t _C7X10Y_SPEED_MED;
 extern const uint8_t _C7X10Y_SPEED_FAST;
 
+extern const uint8_t _C7X10Y_ORIENT_NORMAL;
+extern const uint8_t _C7X10Y_ORIENT_FLIP_H;
+extern const uint8_t _C7X10Y_ORIENT_FLIP_V;
+extern const uint8_t _C7X10Y_ORIENT_ROT180;
+
+extern const uint8_t _C7X10Y_BLEND_OFF;
+extern const uint8_t _C7X10Y_BLEND_OR;
+extern const uint8_t _C7X10Y_BLEND_AND;
+extern const uint8_t _C7X10Y_BLEND_XOR;
+
+extern const uint8_t _C7X10Y_LAYER_BACKGROUND;
+extern const uint8_t _C7X10Y_LAYER_CONTENT;
+extern const uint8_t _C7X10Y_LAYER_OVERLAY;
+
+extern const uint8_t _C7X10Y_BLIT_SET;
+extern const uint8_t _C7X10Y_BLIT_CLEAR;
+extern const uint8_t _C7X10Y_BLIT_XOR;
+
+extern const uint8_t _C7X10Y_BRIGHTNESS_MAX;
+
 /// @}
 /** @section                                    C7x10Y_TYPES Click Types
  *  @{                                    *///----------------------------------
 
-// ...
+/**
+ * @struct T_c7x10y_timing
+ * @brief Row timing profile
+ *
+ * All values are in microseconds, zero skips the delay entirely.
+ */
+typedef struct
+{
+    uint16_t    latchPulse;     /**< Latch and row clock pulse width */
+    uint16_t    rowDwell;       /**< Time each row stays lit */
+    uint16_t    blankGap;       /**< Dark time between two rows (ghosting) */
+    uint16_t    resetPulse;     /**< Module and row counter reset pulse width */
 
+}T_c7x10y_timing;
 
+/**
+ * @brief DMA transfer start function
+ *
+ * Application provided function which starts DMA (or FIFO interrupt) driven
+ * SPI transfer of ```nBytes``` from ```pBuf``` and returns immediately.
+ */
+typedef void (*T_c7x10y_spiDmaFp)(uint8_t *pBuf, uint16_t nBytes);
 
+/**
+ * @brief Microsecond clock function
+ *
+ * Application provided function returning free running microsecond counter,
+ * wrap around is allowed.
+ */
+typedef uint32_t (*T_c7x10y_clockFp)(void);
+
+/** Minimum latency profile - fast ARM targets */
+extern const T_c7x10y_timing _C7X10Y_TIMING_FAST;
+/** Conservative profile - PIC/AVR targets, default after init */
+extern const T_c7x10y_timing _C7X10Y_TIMING_SAFE;
+
+/**
+ * @struct T_c7x10y_frame
+ * @brief Frame buffer
+ *
+ * One word per row and panel from the left, bit 0 is column 1 and bit 9 is
+ * column 10. Converted to the column register format at scan time.
+ * Grayscale bit planes are added on top of full brightness pixels.
+ */
+typedef struct
+{
+    uint16_t px[7][ C7X10Y_PANELS_MAX ];
+#if C7X10Y_GRAY_BITS > 1
+    uint16_t gray[ C7X10Y_GRAY_BITS ][7][ C7X10Y_PANELS_MAX ];
+#endif
+
+}T_c7x10y_frame;
+
+/**
+ * Packs one panel row of an image, arguments are columns 1 to 10 (0 or 1).
+ * Rows are packed by the compiler into the frame buffer format, so
+ * ```c7x10y_drawImage``` copies them without conversion.
+ *
+ * @note ```tools/c7x10y_image.py``` generates images from PBM or ASCII art.
+ */
+#define C7X10Y_ROW( c1, c2, c3, c4, c5, c6, c7, c8, c9, c10 )            \
+    ( (c1) | (c2) << 1 | (c3) << 2 | (c4) << 3 | (c5) << 4 |             \
+      (c6) << 5 | (c7) << 6 | (c8) << 7 | (c9) << 8 | (c10) << 9 )
+
+/**
+ * @struct T_c7x10y_range
+ * @brief Font code range
+ */
+typedef struct
+{
+    uint8_t         first;      /**< First code */
+    uint8_t         last;       /**< Last code */
+    uint16_t        glyph;      /**< Glyph index of the first code */
+
+}T_c7x10y_range;
+
+/**
+ * @struct T_c7x10y_font
+ * @brief Text font
+ *
+ * Only codes in the ranges have glyphs, other codes are drawn with the
+ * default glyph. Glyphs are 5 columns wide at most - fixed width font has
+ * no metrics and each glyph takes 5 columns, proportional font takes only
+ * the glyph columns given by its metrics.
+ *
+ * @note Ranges are searched in order, first one should hold ASCII so its
+ * lookup takes a single compare.
+ *
+ * @note ```tools/c7x10y_font.py``` compiles BDF or PSF fonts, optionally
+ * subset to the characters of the application messages.
+ */
+typedef struct
+{
+    const uint8_t           *glyphs;       /**< 5 columns per glyph, bit 0 is the top row */
+    const uint8_t           *metrics;      /**< Per glyph first column (high nibble) and width (low nibble), 0 for fixed width */
+    const uint8_t           *kerning;      /**< Left code, right code and signed gap change triplets ended by 0, or 0 */
+    const T_c7x10y_range    *ranges;
+    uint8_t                 rangeCount;
+    uint16_t                defaultGlyph;  /**< Glyph index of codes out of ranges */
+
+}T_c7x10y_font;
+
+#if C7X10Y_BUILTIN_FONT
+/** Fixed width 5x7 font, default after init */
+extern const T_c7x10y_font _C7X10Y_FONT_FIXED;
+/** Proportional 5x7 font with kerning */
+extern const T_c7x10y_font _C7X10Y_FONT_PROP;
+#endif
+
+/**
+ * @struct T_c7x10y_sprite
+ * @brief Sprite
+ *
+ * Position and velocity are in 1/256 of a pixel, velocity is added on each
+ * ```c7x10y_tick``` call. Position is 24.8 so sprites can travel the whole
+ * tiled display and far outside of it.
+ */
+typedef struct
+{
+    const uint8_t           *bitmap;        /**< Bitmap in blit format */
+    uint8_t                 w;
+    uint8_t                 h;
+    volatile int32_t        x;              /**< Column, 0 is the first one */
+    volatile int32_t        y;              /**< Row, 0 is the first one */
+    int16_t                 vx;
+    int16_t                 vy;
+    uint8_t                 z;              /**< Higher is drawn over lower */
+    bool                    visible;
+
+}T_c7x10y_sprite;
+
+/* Maximum columns per character - glyph and the gap */
+#define   C7X10Y_PITCH              ( 5 + C7X10Y_CHAR_GAP )
+
+/* Scrolled text ring row size - display width rounded up to whole words */
+#define   C7X10Y_VIEW_WORDS         ( ( C7X10Y_PANELS_MAX * 10 + 15 ) / 16 )
+
+/**
+ * @struct T_c7x10y_ctx
+ * @brief Driver instance
+ *
+ * Holds complete state of one click board - pin and SPI bindings, frame
+ * buffers, scan and scroll state. Should be treated as opaque, it is
+ * initialized by ```c7x10y_init``` and passed to all driver functions.
+ */
+typedef struct T_c7x10y_ctx
+{
+    T_C7X10Y_P              panelGpio[ C7X10Y_PANELS_MAX ]; /**< GPIO mapping per panel */
+    T_C7X10Y_P              spiObj;         /**< SPI mapping */
+    uint8_t                 panels;         /**< Number of tiled panels */
+    uint8_t                 panel;          /**< Panel HAL is mapped to */
+
+    T_c7x10y_frame          frameBuf[2];    /**< Front/back buffer pair */
+#if C7X10Y_COMPOSE
+    T_c7x10y_frame          layerBuf[ C7X10Y_LAYERS ];
+    uint8_t                 layerMode[ C7X10Y_LAYERS ];
+    uint8_t                 layer;          /**< Layer used by drawing */
+    uint8_t                 textLayer;      /**< Layer of scrolled text */
+    volatile bool           composeReq;     /**< Composition left for the main side */
+#endif
+#if C7X10Y_SPRITES_MAX > 0
+    T_c7x10y_sprite         sprite[ C7X10Y_SPRITES_MAX ];
+    uint8_t                 spriteOrder[ C7X10Y_SPRITES_MAX ]; /**< Sprites by z */
+    volatile uint8_t        spriteSeq;      /**< Changed by each motion tick */
+    volatile uint8_t        spriteBusy;     /**< Sprite written by main side + 1, 0 none */
+#endif
+    T_c7x10y_frame          *frame;         /**< Buffer used by drawing */
+    T_c7x10y_frame          *scanFrame;     /**< Buffer being displayed */
+    volatile bool           presentReq;     /**< Swap at the next frame */
+
+    volatile uint8_t        scanRowIdx;     /**< Next row to be driven */
+    uint8_t                 scanPlane;      /**< Next grayscale plane */
+    volatile uint16_t       scanOffTime;    /**< Pending dark part of row */
+    uint16_t                scanWait;       /**< Time left to next step */
+    uint8_t                 colLatch[ C7X10Y_PANELS_MAX * 2 ]; /**< Lit column registers */
+    uint16_t                rowNext[ C7X10Y_PANELS_MAX ]; /**< Row data waiting for the bus */
+    volatile uint16_t       rowPending;     /**< Panels with row data waiting */
+    T_c7x10y_timing         timing;         /**< Active timing profile */
+    uint8_t                 brightGain;     /**< Lit part of row (x/256) */
+
+    uint8_t                 orientation;
+    uint8_t                 rowMap[7];      /**< Frame row of each scan row */
+    uint8_t                 panelMap[ C7X10Y_PANELS_MAX ]; /**< Frame panel of each panel */
+    const uint8_t           *colMap;        /**< Column register bit order */
+    uint8_t                 colShift[2];    /**< Row half of each register */
+
+    uint8_t                 clipTop;        /**< First row drawn (from 0) */
+    uint8_t                 clipBottom;     /**< Last row drawn (from 0) */
+    uint16_t                clipMask[ C7X10Y_PANELS_MAX ]; /**< Columns drawn */
+
+    uint16_t                resyncFrames;   /**< Resync period, 0 is off */
+    uint16_t                resyncCount;
+    volatile bool           resyncReq;
+    uint8_t                 rowCounter;     /**< Row counter output, 0xFF unknown */
+
+    T_c7x10y_clockFp        clockFp;        /**< Governor clock */
+    bool                    govRun;
+    uint32_t                govFrameStart;
+    uint32_t                targetPeriod;   /**< Target frame period (us) */
+    uint32_t                framePeriod;    /**< Measured frame period (us) */
+    uint32_t                scanTime;       /**< Scan time in frame (us) */
+
+    bool                    scroll;
+    uint8_t                 strip[ C7X10Y_TEXT_MAX * C7X10Y_PITCH ]; /**< Text columns, bit 0 is the top row */
+    uint16_t                stripLength;    /**< Text columns used */
+    const T_c7x10y_font     *textFont;
+    uint8_t                 textLast;       /**< Last character of the text */
+    uint16_t                textCol;        /**< Next strip column scrolled in */
+    uint16_t                view[7][ C7X10Y_VIEW_WORDS ]; /**< Scrolled text ring, bit per column */
+    uint16_t                viewOffset;     /**< Ring bit of the leftmost display column */
+    uint16_t                scrollLeft;     /**< Steps to the scroll end */
+    bool                    scrollRestart;  /**< Rewind at the next enable */
+#if C7X10Y_STREAM_SIZE > 0
+    volatile char           stream[ C7X10Y_STREAM_SIZE ]; /**< Appended characters */
+    volatile uint8_t        streamHead;     /**< Written by producer only */
+    volatile uint8_t        streamTail;     /**< Written by scroll only */
+    uint8_t                 glyph[ C7X10Y_PITCH ]; /**< Streamed character gap and columns */
+    uint8_t                 glyphLen;
+    uint8_t                 glyphPos;       /**< Next glyph column */
+    uint8_t                 streamPrev;     /**< Last character scrolled in */
+    bool                    streamOnly;     /**< Scroll the stream only, never ends */
+#endif
+    volatile uint16_t       timerTick;      /**< Scroll speed ticks */
+    uint8_t                 scrollSpeed;
+
+    struct T_c7x10y_ctx     *next;          /**< Next scanned instance */
+
+}T_c7x10y_ctx;
 
 /// @}
 
@@ -105,7 +411,41 @@ extern "C"{
  *  @{                           *///-------------------------------------------
 
 #ifdef   __C7X10Y_DRV_SPI__
-void c7x10y_spiDriverInit(T_C7X10Y_P gpioObj, T_C7X10Y_P spiObj);
+/**
+ * @brief Driver instance init
+ *
+ * Initializes instance, binds it to the provided pins and SPI module and
+ * adds it to the instances scanned by ```c7x10y_scanStep```. Every click
+ * board needs its own instance, all of them share one SPI bus.
+ *
+ * @param[in] ctx       driver instance
+ * @param[in] gpioObj   GPIO mapping of the mikroBUS socket
+ * @param[in] spiObj    SPI mapping
+ *
+ * @warning Init changes the scanned instance list and remaps the pins and
+ * SPI module without a guard against the scan interrupt. All
+ * ```c7x10y_init``` and ```c7x10y_addPanel``` calls must be done before
+ * the timer calling ```c7x10y_scanStep``` is started.
+ */
+void c7x10y_init( T_c7x10y_ctx *ctx, T_C7X10Y_P gpioObj, T_C7X10Y_P spiObj );
+
+/**
+ * @brief Add panel
+ *
+ * Adds click board placed right of the last one, display becomes 10 columns
+ * wider. Text, scrolling and drawing functions work over the whole width,
+ * all panels are scanned in the same row step.
+ *
+ * @param[in] ctx       driver instance
+ * @param[in] gpioObj   GPIO mapping of the panel mikroBUS socket
+ *
+ * @note Panels share the SPI module of the instance, number of panels is
+ * limited by ```C7X10Y_PANELS_MAX```.
+ *
+ * @warning Must be called before the scan timer is started, same as
+ * ```c7x10y_init```.
+ */
+void c7x10y_addPanel( T_c7x10y_ctx *ctx, T_C7X10Y_P gpioObj );
 #endif
 #ifdef   __C7X10Y_DRV_I2C__
 void c7x10y_i2cDriverInit(T_C7X10Y_P gpioObj, T_C7X10Y_P i2cObj, uint8_t slave);
@@ -118,22 +458,253 @@ void c7x10y_uartDriverInit(T_C7X10Y_P gpioObj, T_C7X10Y_P uartObj);
 /** @section                                C7x10Y_FUNC Driver Functions
  *  @{                                *///--------------------------------------
 
+/* All functions except global scan and DMA ones take the driver instance
+   initialized by ```c7x10y_init``` as the first argument. */
+
 /**
  * @brief Refresh display
  *
- * Draws content of frame buffer.
+ * Draws content of frame buffer. Blocks for the whole frame period (7 row
+ * periods) at any non-zero brightness, returns at once for an empty frame
+ * or brightness 0.
  *
  * @note 
  * Needs to be called as frequently as possible.
  */
-bool c7x10y_refreshDisplay( void );
+bool c7x10y_refreshDisplay( T_c7x10y_ctx *ctx );
+
+/**
+ * @brief Single row scan step
+ *
+ * Non-blocking alternative to ```c7x10y_refreshDisplay```. Every call drives
+ * exactly one row of the frame buffer and returns, so it is meant to be
+ * called from a timer interrupt routine while the application only updates
+ * the frame buffer.
+ *
+ * All initialized instances are scanned, row steps of different instances
+ * are interleaved so every display keeps its own row period.
+ *
+ * @return time in microseconds to the next step (next timer period)
+ *
+ * @note
+ * Scrolling is also advanced from here at the start of each frame.
+ */
+uint16_t c7x10y_scanStep( void );
+
+/**
+ * @brief Set refresh rate
+ *
+ * Sets target frame rate. Row period returned from ```c7x10y_scanStep```
+ * and row on-time of ```c7x10y_refreshDisplay``` are calculated from this
+ * value.
+ *
+ * When clock function is provided by ```c7x10y_setClock``` achieved frame
+ * period is measured. Time spent outside of the refresh (application loop
+ * or interrupt latency) lowers the rate, row dwell is shortened only to
+ * hold the lowest flicker free rate (70 Hz) and never below half of the
+ * nominal one, so brightness stays constant under normal load.
+ *
+ * @param[in] hz    frames per second (default is ~143 Hz - 1 ms per row)
+ *
+ * @note Overrides ```rowDwell``` of the active timing profile.
+ */
+void c7x10y_setRefreshHz( T_c7x10y_ctx *ctx, uint16_t hz );
+
+/**
+ * @brief Set clock function
+ *
+ * Enables refresh rate measurement and governor.
+ *
+ * @param[in] clock    microsecond clock function, 0 disables the governor
+ */
+void c7x10y_setClock( T_c7x10y_ctx *ctx, T_c7x10y_clockFp clock );
+
+/**
+ * @brief Get achieved refresh rate
+ *
+ * @return measured frames per second, 0 if not measured
+ */
+uint16_t c7x10y_getRefreshHz( T_c7x10y_ctx *ctx );
+
+/**
+ * @brief Set brightness
+ *
+ * Brightness is controlled by the part of the row period row stays lit,
+ * levels are gamma corrected. Rest of the period is done as a separate
+ * dark step with the columns blanked, by both ```c7x10y_scanStep``` and
+ * ```c7x10y_refreshDisplay```. At level 0 ```c7x10y_refreshDisplay```
+ * returns at once, same as for an empty frame.
+ *
+ * @note Blocking refresh waits through the dark part too, so it takes the
+ * full frame period at every level from 1 up - lower brightness does not
+ * free CPU time. Use ```c7x10y_scanStep``` to get the dark time back.
+ *
+ * @param[in] level    0 (off) to ```_C7X10Y_BRIGHTNESS_MAX``` (default)
+ */
+void c7x10y_setBrightness( T_c7x10y_ctx *ctx, uint8_t level );
+
+/**
+ * @brief Set resync policy
+ *
+ * Module and row counter are reset at init only, the scan clocks the row
+ * counter around the frame. Periodic resync resets the module and row
+ * counter and rewrites column registers every ```frames``` frames, to
+ * recover from possible glitches on long cables or noisy supply.
+ *
+ * @param[in] frames    resync period in frames, 0 disables (default)
+ */
+void c7x10y_setResync( T_c7x10y_ctx *ctx, uint16_t frames );
+
+/**
+ * @brief Request resync
+ *
+ * Module is reset at the start of the next frame. Should be called after
+ * an error (bus error, brown-out ...). Safe to be called from interrupt
+ * routine.
+ */
+void c7x10y_resync( T_c7x10y_ctx *ctx );
+
+/**
+ * @brief Set row timing profile
+ *
+ * Profile is copied, so it can be one of the predefined profiles or
+ * an application defined one.
+ *
+ * @param[in] timing    pointer to timing profile
+ *
+ * @note Init function sets ```_C7X10Y_TIMING_SAFE``` which matches the
+ * timing of the previous driver versions.
+ */
+void c7x10y_setTiming( T_c7x10y_ctx *ctx, const T_c7x10y_timing *timing );
+
+/**
+ * @brief Set display orientation
+ *
+ * Orientation is applied by the scan through row order and column bit
+ * order tables, drawing functions and frame buffer are not affected.
+ *
+ * @param[in] orientation    ```_C7X10Y_ORIENT_NORMAL``` (default),
+ * ```_C7X10Y_ORIENT_FLIP_H```, ```_C7X10Y_ORIENT_FLIP_V``` or
+ * ```_C7X10Y_ORIENT_ROT180```
+ *
+ * @note Horizontal flip of a tiled display also reverses panel order.
+ */
+void c7x10y_setOrientation( T_c7x10y_ctx *ctx, uint8_t orientation );
+
+#ifdef __MIKROC_PRO_FOR_ARM__
+/**
+ * @brief Enable DMA row transfers
+ *
+ * Row data is transferred using provided DMA start function and scan step
+ * returns while transfer is in progress, row is latched from
+ * ```c7x10y_spiDmaDone```. DMA start function should also run an RX DMA
+ * channel, its completion marks the end of the shift out.
+ *
+ * @param[in] dmaStart    DMA start function or 0 for blocking transfers
+ *
+ * @return false if a row transfer is in flight, transfer function is not
+ * changed then - call again later
+ *
+ * @note SPI module used by the DMA must be the one shared by all instances.
+ *
+ * @note Scan never waits for the bus. Transfers of the following panels
+ * are started from ```c7x10y_spiDmaDone```, scan step which finds a
+ * transfer in flight (other instance or slow bus) is retried after 20 us.
+ * Scan timer interrupt must not preempt the interrupt which calls
+ * ```c7x10y_spiDmaDone``` - give that one the same or higher priority.
+ */
+bool c7x10y_setSpiDma( T_c7x10y_spiDmaFp dmaStart );
+
+/**
+ * @brief DMA transfer complete
+ *
+ * Latches the row, so it must be called only after the last bit has left
+ * the SPI shifter. Call it from the transfer complete interrupt of an RX
+ * DMA channel run along the TX one (received bytes are discarded), or
+ * wait for the SPI busy flag to clear before calling it.
+ *
+ * @warning TX DMA complete interrupt fires once the last byte is written
+ * to the data register, while it is still being shifted out - latching
+ * from there corrupts the row.
+ */
+void c7x10y_spiDmaDone( void );
+#endif
+
+/**
+ * @brief Enable double buffering
+ *
+ * When enabled all drawing functions write to the back buffer while the
+ * front buffer is being displayed. Drawn content becomes visible only after
+ * ```c7x10y_present``` call. Current content is copied to the back buffer
+ * when double buffering is enabled.
+ *
+ * @param[in] enable    true - double buffered, false - single buffer (default)
+ *
+ * @note Has no effect with layers enabled.
+ */
+void c7x10y_doubleBuffer( T_c7x10y_ctx *ctx, bool enable );
+
+/**
+ * @brief Present back buffer
+ *
+ * Requests swap of the front and back buffer. Swap is done by the scan at
+ * the next frame boundary, so partially drawn frames are never displayed.
+ * Without layers safe to be called from interrupt routine.
+ *
+ * @return false if the frame was not composited because the previous one
+ * still waits for the swap (layers only), call again later
+ *
+ * @note After the swap back buffer holds the previously displayed frame,
+ * so next frame should be completely redrawn (or cleared first). Drawing
+ * should not start before ```c7x10y_presentPending``` returns false.
+ *
+ * @note With layers enabled layers are composited into the back buffer
+ * first, double buffering is then always used and layers keep their
+ * content. Composition is done by the caller, so it should be called from
+ * the main loop only.
+ */
+bool c7x10y_present( T_c7x10y_ctx *ctx );
+
+#if C7X10Y_COMPOSE
+/**
+ * @brief Select drawing layer
+ *
+ * All drawing functions (including clear) work on the selected layer only,
+ * other layers keep their content.
+ *
+ * @param[in] layer    layer index, 0 is the bottom one
+ * (```_C7X10Y_LAYER_BACKGROUND``` is default)
+ */
+void c7x10y_selectLayer( T_c7x10y_ctx *ctx, uint8_t layer );
+
+/**
+ * @brief Set layer blend mode
+ *
+ * Layers are blended from the bottom up into the empty frame by
+ * ```c7x10y_present```, so changing one layer does not require redrawing
+ * the others. Scrolled text is blended by the mode of the layer selected
+ * when scrolling was enabled.
+ *
+ * @param[in] layer   layer index
+ * @param[in] mode    ```_C7X10Y_BLEND_OR``` (default), ```_C7X10Y_BLEND_AND```,
+ * ```_C7X10Y_BLEND_XOR``` or ```_C7X10Y_BLEND_OFF``` (hidden)
+ */
+void c7x10y_setLayerMode( T_c7x10y_ctx *ctx, uint8_t layer, uint8_t mode );
+#endif
+
+/**
+ * @brief Present request state
+ *
+ * @return true while requested buffer swap is not yet done
+ */
+bool c7x10y_presentPending( T_c7x10y_ctx *ctx );
 
 /**
  * @brief Clear display
  *
  * Clears content of frame buffer.
  */
-void c7x10y_clearDisplay( void );
+void c7x10y_clearDisplay( T_c7x10y_ctx *ctx );
 
 /**
  * @brief Draws a pixel
@@ -145,19 +716,254 @@ void c7x10y_clearDisplay( void );
  *
  * @note 
  * Minimum row value is 1 Maximum is 7
- * Minimum col value is 1 Maximum is 10
+ * Minimum col value is 1 Maximum is 10 for each panel
+ */
+void c7x10y_drawPixel( T_c7x10y_ctx *ctx, uint8_t row, uint8_t col );
+
+/**
+ * @brief Clears a pixel
+ *
+ * @param[in] row   matrix row
+ * @param[in] col   matrix column
+ */
+void c7x10y_clearPixel( T_c7x10y_ctx *ctx, uint8_t row, uint8_t col );
+
+/**
+ * @brief Toggles a pixel
+ *
+ * @param[in] row   matrix row
+ * @param[in] col   matrix column
+ */
+void c7x10y_togglePixel( T_c7x10y_ctx *ctx, uint8_t row, uint8_t col );
+
+/**
+ * @brief Reads a pixel
+ *
+ * @param[in] row   matrix row
+ * @param[in] col   matrix column
+ *
+ * @return true if pixel is set in the frame buffer (false out of display)
  */
-void c7x10y_drawPixel( uint8_t row, uint8_t col );
+bool c7x10y_getPixel( T_c7x10y_ctx *ctx, uint8_t row, uint8_t col );
+
+/**
+ * @brief Draws pixels
+ *
+ * Batched ```c7x10y_drawPixel``` - frame buffer and display width are
+ * fetched once, pixels out of the display are skipped.
+ *
+ * @param[in] pixels   ```count``` pairs of row and column
+ * @param[in] count    number of pixels
+ */
+void c7x10y_drawPixels( T_c7x10y_ctx *ctx, const uint8_t *pixels, uint8_t count );
+
+/**
+ * @brief Clears pixels
+ *
+ * @param[in] pixels   ```count``` pairs of row and column
+ * @param[in] count    number of pixels
+ */
+void c7x10y_clearPixels( T_c7x10y_ctx *ctx, const uint8_t *pixels, uint8_t count );
+
+/**
+ * @brief Toggles pixels
+ *
+ * @param[in] pixels   ```count``` pairs of row and column
+ * @param[in] count    number of pixels
+ */
+void c7x10y_togglePixels( T_c7x10y_ctx *ctx, const uint8_t *pixels, uint8_t count );
+
+/**
+ * @brief Reads pixels
+ *
+ * @param[in] pixels    ```count``` pairs of row and column
+ * @param[in] count     number of pixels
+ * @param[out] states   ```count``` pixel states
+ */
+void c7x10y_getPixels( T_c7x10y_ctx *ctx, const uint8_t *pixels, uint8_t count, bool *states );
+
+/**
+ * @brief Draws a pixel with brightness level
+ *
+ * Level replaces previous state of the pixel. Grayscale is displayed using
+ * binary code modulation, only rows which contain grayscale pixels are
+ * modulated.
+ *
+ * @param[in] row     matrix row
+ * @param[in] col     matrix column
+ * @param[in] level   brightness from 0 to ( 1 << C7X10Y_GRAY_BITS ) - 1
+ *
+ * @note 
+ * With monochrome build any non zero level turns the pixel on.
+ */
+void c7x10y_drawPixelLevel( T_c7x10y_ctx *ctx, uint8_t row, uint8_t col, uint8_t level );
+
+/**
+ * @brief Draws an image
+ *
+ * Copies the image to the frame buffer. Image is clipped to the display
+ * width, panels right of a narrower image are cleared.
+ *
+ * @param[in] image   7 rows of one word per panel from the left, packed by
+ * ```C7X10Y_ROW``` (bit 0 is the leftmost column)
+ * @param[in] panels  image width in panels (words per row), generated
+ * images define it as ```NAME_PANELS```
+ */
+void c7x10y_drawImage( T_c7x10y_ctx *ctx, const uint16_t *image, uint8_t panels );
+
+/**
+ * @brief Draws a line
+ *
+ * Bresenham line between two points, both included. Horizontal lines are
+ * drawn a panel word at a time. Parts outside of the display are skipped.
+ *
+ * @param[in] col0   column of the first point (1 is the first column)
+ * @param[in] row0   row of the first point (1 is the first row)
+ * @param[in] col1   column of the second point
+ * @param[in] row1   row of the second point
+ */
+void c7x10y_drawLine( T_c7x10y_ctx *ctx, int16_t col0, int16_t row0, int16_t col1, int16_t row1 );
+
+/**
+ * @brief Draws a rectangle outline
+ *
+ * @param[in] col   column of the left edge (1 is the first column)
+ * @param[in] row   row of the top edge (1 is the first row)
+ * @param[in] w     width in columns
+ * @param[in] h     height in rows
+ */
+void c7x10y_drawRect( T_c7x10y_ctx *ctx, int16_t col, int16_t row, uint8_t w, uint8_t h );
+
+/**
+ * @brief Fills a rectangle
+ *
+ * Each row is masked into the panel words at once.
+ *
+ * @param[in] col   column of the left edge (1 is the first column)
+ * @param[in] row   row of the top edge (1 is the first row)
+ * @param[in] w     width in columns
+ * @param[in] h     height in rows
+ * @param[in] op    ```_C7X10Y_BLIT_SET```, ```_C7X10Y_BLIT_CLEAR``` or
+ * ```_C7X10Y_BLIT_XOR```
+ */
+void c7x10y_fillRect( T_c7x10y_ctx *ctx, int16_t col, int16_t row, uint8_t w, uint8_t h, uint8_t op );
+
+/**
+ * @brief Draws a circle outline
+ *
+ * @param[in] col      column of the center (1 is the first column)
+ * @param[in] row      row of the center (1 is the first row)
+ * @param[in] radius   radius in pixels
+ */
+void c7x10y_drawCircle( T_c7x10y_ctx *ctx, int16_t col, int16_t row, uint8_t radius );
+
+/**
+ * @brief Flood fills an area
+ *
+ * Lights the dark area around the start pixel bounded by lit pixels
+ * (4-connected). Fill grows whole row words, so its duration depends on
+ * the area shape rather than its size.
+ *
+ * @param[in] col   start column (1 is the first column)
+ * @param[in] row   start row (1 is the first row)
+ *
+ * @note Nothing is drawn if the start pixel is already lit.
+ */
+void c7x10y_floodFill( T_c7x10y_ctx *ctx, uint8_t col, uint8_t row );
+
+/**
+ * @brief Set clip rectangle
+ *
+ * Bitmaps are drawn inside the clip rectangle only. Init (and adding a
+ * panel) sets clip rectangle to the whole display. Rectangle is cut to the
+ * display, zero width or height clips everything.
+ *
+ * @param[in] col   first column (1 is the first column)
+ * @param[in] row   first row (1 is the first row)
+ * @param[in] w     width in columns
+ * @param[in] h     height in rows
+ */
+void c7x10y_setClip( T_c7x10y_ctx *ctx, uint8_t col, uint8_t row, uint8_t w, uint8_t h );
+
+/**
+ * @brief Draws a bitmap
+ *
+ * Bitmap is drawn a whole row at a time, with shift and mask per row and
+ * panel. Parts outside of the display or clip rectangle are skipped, so
+ * position can be negative.
+ *
+ * @param[in] bitmap   bitmap rows, ( w + 7 ) / 8 bytes per row,
+ * bit 0 of the first byte is the leftmost column
+ * @param[in] w        width from 1 to 16
+ * @param[in] h        height
+ * @param[in] col      column of the left edge (1 is the first column)
+ * @param[in] row      row of the top edge (1 is the first row)
+ * @param[in] op       ```_C7X10Y_BLIT_SET```, ```_C7X10Y_BLIT_CLEAR``` or
+ * ```_C7X10Y_BLIT_XOR```
+ */
+void c7x10y_blit( T_c7x10y_ctx *ctx, const uint8_t *bitmap, uint8_t w, uint8_t h, int16_t col, int16_t row, uint8_t op );
+
+/**
+ * @brief Glyph index
+ *
+ * @param[in] fnt    font
+ * @param[in] ch     character code
+ *
+ * @return index of the character glyph, default glyph if there is none
+ */
+uint16_t c7x10y_fontIndex( const T_c7x10y_font *fnt, uint8_t ch );
+
+/**
+ * @brief Glyph columns
+ *
+ * @param[in] fnt    font
+ * @param[in] ch     character code
+ *
+ * @return 5 glyph columns, bit 0 is the top row
+ */
+const uint8_t *c7x10y_fontGlyph( const T_c7x10y_font *fnt, uint8_t ch );
+
+/**
+ * @brief Glyph width
+ *
+ * @param[in] fnt    font
+ * @param[in] ch     character code
+ *
+ * @return columns taken by the character, without the gap
+ */
+uint8_t c7x10y_fontWidth( const T_c7x10y_font *fnt, uint8_t ch );
+
+/**
+ * @brief Sets text font
+ *
+ * Used by text drawn or appended afterwards.
+ *
+ * @param[in] fnt    ```_C7X10Y_FONT_FIXED```, ```_C7X10Y_FONT_PROP``` or
+ * application font
+ *
+ * @note Without ```C7X10Y_BUILTIN_FONT``` there is no font after init, text
+ * functions do nothing until one is set.
+ */
+void c7x10y_setFont( T_c7x10y_ctx *ctx, const T_c7x10y_font *fnt );
+
+/**
+ * @brief Text width
+ *
+ * @param[in] txt    text to be measured
+ *
+ * @return width in columns with the current font, gaps and kerning
+ */
+uint16_t c7x10y_textWidth( T_c7x10y_ctx *ctx, char *txt );
 
 /**
  * @brief Write Text
  *
- * Text will be placed inside internal text buffer, but first two 
- * characters are automaticly placen inside frame buffer.
+ * Whole text is rendered to the internal text strip, part which fits the
+ * display is placed inside frame buffer.
  *
  * @param[in] txt    text to be written
  */
-void c7x10y_drawText( char *txt );
+void c7x10y_drawText( T_c7x10y_ctx *ctx, char *txt );
 
 /**
  * @brief Draws numbers
@@ -166,7 +972,7 @@ void c7x10y_drawText( char *txt );
  *
  * @param[in] num    number to draw
  */
-void c7x10y_drawNumber( uint8_t num );
+void c7x10y_drawNumber( T_c7x10y_ctx *ctx, uint8_t num );
 
 /**
  * @brief Enable scrolling feature
@@ -179,13 +985,68 @@ void c7x10y_drawNumber( uint8_t num );
  * @note Scrolling speed depends of provided speed and already defined constants
  * should be used as argument. Also scroll speed depends of ```c7x10y_tick``` calling
  * frequency.
+ *
+ * @note While scrolling the display shows the scrolled text, frame buffer
+ * content is shown again when scrolling ends. Next scroll starts from the
+ * text start, unless it was stopped by ```c7x10y_scrollDisable```. With
+ * layers the text is blended over the other layers including their
+ * grayscale pixels.
+ */
+void c7x10y_scrollEnable( T_c7x10y_ctx *ctx, uint8_t speed );
+
+#if C7X10Y_STREAM_SIZE > 0
+/**
+ * @brief Appends text to the scroll
+ *
+ * Characters are queued and scrolled in after the text of
+ * ```c7x10y_drawText``` and the previously appended ones, each is
+ * rasterized just before it enters the display. Scrolling ends once all
+ * queued text has left the display, unless ```c7x10y_streamMode``` keeps
+ * it running.
+ *
+ * @param[in] chars   characters to append
+ * @param[in] n       number of characters
+ *
+ * @return number of characters queued, less than ```n``` when the ring
+ * is full
+ *
+ * @note Safe to call from an interrupt routine (a UART receive one for
+ * example) while scrolling runs from ```c7x10y_scanStep``` or the main
+ * loop, as long as there is one caller per instance.
  */
-void c7x10y_scrollEnable( uint8_t speed );
+uint8_t c7x10y_textAppend( T_c7x10y_ctx *ctx, char *chars, uint8_t n );
+
+/**
+ * @brief Selects stream only scrolling
+ *
+ * @param[in] only    true scrolls appended text only
+ *
+ * In stream only mode the text of ```c7x10y_drawText``` is skipped, the
+ * scroll starts blank and keeps running with blank columns while no text
+ * is queued, so a slow feed is shown as it arrives. Scroll stops only by
+ * ```c7x10y_scrollDisable```. Takes effect at the next
+ * ```c7x10y_scrollEnable```.
+ */
+void c7x10y_streamMode( T_c7x10y_ctx *ctx, bool only );
+#endif
 
 /**
  * @brief Disables scrolling
  */
-void c7x10y_scrollDisable( void );
+void c7x10y_scrollDisable( T_c7x10y_ctx *ctx );
+
+/**
+ * @brief Scrolling state
+ *
+ * @return true while scrolling is in progress
+ *
+ * @note Used when display is refreshed by ```c7x10y_scanStep``` and return
+ * value of ```c7x10y_refreshDisplay``` is not available.
+ *
+ * @note With layers the frame including the text layer is composited here
+ * once the scroll has ended, scan interrupt only requests it.
+ */
+bool c7x10y_scrollActive( T_c7x10y_ctx *ctx );
 
 /**
  * @brief Tick called to control scrolling speed
@@ -193,8 +1054,93 @@ void c7x10y_scrollDisable( void );
  * This function is used on the scrolling feature.  It is to be called
  * after starting the scroll and around each display refresh. It does not
  * need to be called if scrolling is not needed.
+ *
+ * @note Visible sprites are moved by their velocity on each call. Tick may
+ * run from interrupt, ```c7x10y_present``` and the sprite getters and
+ * collision tests read positions of one and the same tick.
+ */
+void c7x10y_tick( T_c7x10y_ctx *ctx );
+
+#if C7X10Y_SPRITES_MAX > 0
+/**
+ * @brief Set sprite bitmap
+ *
+ * @param[in] id       sprite index from 0 to ```C7X10Y_SPRITES_MAX``` - 1
+ * @param[in] bitmap   bitmap in ```c7x10y_blit``` format, must stay valid
+ * @param[in] w        width from 1 to 16
+ * @param[in] h        height
+ *
+ * @note Sprites are drawn by ```c7x10y_present```, which should be called
+ * after sprites are changed or moved (for example once per frame).
  */
-void c7x10y_tick( void );
+void c7x10y_spriteSet( T_c7x10y_ctx *ctx, uint8_t id, const uint8_t *bitmap, uint8_t w, uint8_t h );
+
+/**
+ * @brief Move sprite
+ *
+ * @param[in] id    sprite index
+ * @param[in] col   column of the left edge (1 is the first column)
+ * @param[in] row   row of the top edge (1 is the first row)
+ */
+void c7x10y_spriteMove( T_c7x10y_ctx *ctx, uint8_t id, int16_t col, int16_t row );
+
+/**
+ * @brief Set sprite velocity
+ *
+ * @param[in] id    sprite index
+ * @param[in] vx    columns per tick in 1/256 (256 moves one column per tick)
+ * @param[in] vy    rows per tick in 1/256
+ */
+void c7x10y_spriteSpeed( T_c7x10y_ctx *ctx, uint8_t id, int16_t vx, int16_t vy );
+
+/**
+ * @brief Set sprite z-order
+ *
+ * @param[in] id    sprite index
+ * @param[in] z     sprites with higher value are drawn over lower ones
+ */
+void c7x10y_spriteZ( T_c7x10y_ctx *ctx, uint8_t id, uint8_t z );
+
+/**
+ * @brief Show or hide sprite
+ *
+ * Hidden sprites are not drawn, moved nor tested for collisions.
+ *
+ * @param[in] id        sprite index
+ * @param[in] visible   true to show the sprite
+ */
+void c7x10y_spriteShow( T_c7x10y_ctx *ctx, uint8_t id, bool visible );
+
+/**
+ * @brief Sprite column
+ *
+ * @return current column of the left edge
+ */
+int16_t c7x10y_spriteCol( T_c7x10y_ctx *ctx, uint8_t id );
+
+/**
+ * @brief Sprite row
+ *
+ * @return current row of the top edge
+ */
+int16_t c7x10y_spriteRow( T_c7x10y_ctx *ctx, uint8_t id );
+
+/**
+ * @brief Sprite collision
+ *
+ * Bitmaps are compared row by row, so only lit pixels collide.
+ *
+ * @return true if sprites ```a``` and ```b``` overlap
+ */
+bool c7x10y_spriteHit( T_c7x10y_ctx *ctx, uint8_t a, uint8_t b );
+
+/**
+ * @brief Sprite collision with background
+ *
+ * @return true if any lit sprite pixel is over lit pixel of the bottom layer
+ */
+bool c7x10y_spriteHitBg( T_c7x10y_ctx *ctx, uint8_t id );
+#endif
 
 ///@}
 
@@ -63,6 +63,9 @@
 /** @section                                         HAL_SPI HAL SPI Interface
  *  @{                                         *///-----------------------------
 
+typedef void    (*T_hal_spiDoneFp)();                  /**< Transfer Done Callback */
+typedef void    (*T_hal_spiDmaFp)(uint8_t*, uint16_t); /**< DMA Transfer Start Function Pointer */
+
 /**
  * @brief Map SPI Function Pointers
  */
@@ -108,6 +111,53 @@ static void hal_spiRead(uint8_t *pBuf, uint16_t nBytes);
  */
 static void hal_spiTransfer(uint8_t *pIn, uint8_t *pOut, uint16_t nBytes);
 
+/**
+ * @brief hal_spiWriteAsync
+ *
+ * @param[in] pBuf             pointer to data buffer
+ * @param[in] nBytes           number of bytes for writing
+ * @param[in] doneCb           called when the last byte is shifted out
+ *
+ * Function starts write sequence of n bytes and returns. Buffer must stay
+ * valid until the callback is called. With DMA the callback comes from
+ * hal_spiAsyncDone, so the shift out is only complete if that one is
+ * called at the right moment.
+ *
+ * @note
+ * Targets without DMA support write synchronously and call the callback
+ * before returning.
+ */
+static void hal_spiWriteAsync(uint8_t *pBuf, uint16_t nBytes, T_hal_spiDoneFp doneCb);
+
+#ifdef __MIKROC_PRO_FOR_ARM__
+/**
+ * @brief Map DMA Transfer Function
+ *
+ * @param[in] dmaStart         function starting DMA transfer, 0 disables DMA
+ *
+ * @return    0                No Error
+ *
+ * Transfer function is provided by the application because HAL SPI object
+ * carries no information about SPI module and DMA channel in use.
+ *
+ * @note
+ * Refused while a transfer is in flight, its done callback would be lost.
+ */
+static int hal_spiDmaMap(T_hal_spiDmaFp dmaStart);
+
+/**
+ * @brief hal_spiAsyncDone
+ *
+ * Function should be called once the last byte is shifted out - from RX
+ * DMA transfer complete interrupt, or after SPI busy flag clears.
+ *
+ * @note
+ * TX DMA transfer complete fires while the last byte is still in the
+ * shifter, HAL can not wait for it as SPI registers are not known here.
+ */
+static void hal_spiAsyncDone();
+#endif
+
 ///@}
 
 #endif
@@ -0,0 +1,361 @@
+#!/usr/bin/env python3
+"""
+    c7x10y_font.py
+
+    Compiles BDF or PSF (version 1 and 2) fonts to the 7x10_Y click driver
+    font format - code ranges of 5 column glyphs, optional proportional
+    metrics and a T_c7x10y_font object to pass to c7x10y_setFont.
+
+    Glyph ink of ASCII and selected characters has to fit 5 columns and 7
+    rows, it is cropped to its common bounding box. --clip cuts larger glyphs
+    instead of failing.
+
+    Character codes are the bytes of the firmware strings. --encoding maps
+    them to the Unicode characters looked up in the font (latin-1 keeps
+    codes as they are).
+
+    Subsetting - with --chars and/or --text only the characters used are
+    compiled, plus the default glyph. Without them all characters from
+    code 32 up found in the font are compiled, except blank ones (space
+    is kept).
+
+    Usage:
+        c7x10y_font.py [--chars CHARS] [--text FILE ...] [--proportional]
+                       [--space N] [--encoding ENC] [--default CHAR]
+                       [--name NAME] [--clip] [-o OUT] FONT
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+PSF1_MAGIC = b"\x36\x04"
+PSF2_MAGIC = b"\x72\xb5\x4a\x86"
+
+
+def read_bdf(data):
+    """Returns { unicode : (rows of ink bits, advance) }, rows are lists of
+    0/1 on a common cell where row 0 is the top one."""
+    glyphs = {}
+    ascent = None
+    bbox = None
+    lines = iter(data.decode("latin-1").splitlines())
+
+    for line in lines:
+        words = line.split()
+        if not words:
+            continue
+        if words[0] == "FONTBOUNDINGBOX":
+            bbox = [int(w) for w in words[1:5]]
+        elif words[0] == "FONT_ASCENT":
+            ascent = int(words[1])
+        elif words[0] == "STARTCHAR":
+            code, bbx, advance, bits = -1, None, None, []
+            for line in lines:
+                words = line.split()
+                if not words:
+                    continue
+                if words[0] == "ENCODING":
+                    code = int(words[1])
+                elif words[0] == "BBX":
+                    bbx = [int(w) for w in words[1:5]]
+                elif words[0] == "DWIDTH":
+                    advance = int(words[1])
+                elif words[0] == "BITMAP":
+                    for line in lines:
+                        if line.strip() == "ENDCHAR":
+                            break
+                        bits.append(int(line.strip(), 16))
+                    break
+            if code < 0 or bbx is None:
+                continue
+            glyphs[code] = (bbx, advance, bits)
+
+    if bbox is None:
+        raise ValueError("BDF has no FONTBOUNDINGBOX")
+
+    if ascent is None:
+        ascent = bbox[1] + bbox[3]
+
+    height = bbox[1]
+    width = bbox[0] + max(0, bbox[2])
+    cells = {}
+
+    # Glyph boxes are placed on the baseline of the font cell
+    for code, ((w, h, xoff, yoff), advance, bits) in glyphs.items():
+        cell = [[0] * max(width, xoff + w) for r in range(height)]
+        stride = (w + 7) // 8 * 8
+        for r, row in enumerate(bits[:h]):
+            y = ascent - (yoff + h) + r
+            if not 0 <= y < height:
+                continue
+            for c in range(w):
+                if (row >> (stride - 1 - c)) & 1 and xoff + c >= 0:
+                    cell[y][xoff + c] = 1
+        cells[code] = (cell, advance if advance is not None else w)
+
+    return cells
+
+
+def psf_glyph(data, width, height):
+    stride = (width + 7) // 8
+    return [[(data[r * stride + (c >> 3)] >> (7 - (c & 7))) & 1
+             for c in range(width)] for r in range(height)]
+
+
+def read_psf(data):
+    """Returns { unicode : (rows of ink bits, advance) } of a PSF font."""
+    if data[:2] == PSF1_MAGIC:
+        mode, charsize = data[2], data[3]
+        count = 512 if mode & 0x01 else 256
+        width, height, offset = 8, charsize, 4
+        has_table = mode & 0x06
+    elif data[:4] == PSF2_MAGIC:
+        (version, offset, flags, count, charsize,
+         height, width) = struct.unpack("<7I", data[4:32])
+        has_table = flags & 0x01
+    else:
+        raise ValueError("not a PSF font")
+
+    table = offset + count * charsize
+    if len(data) < table:
+        raise ValueError("PSF data too short")
+
+    raw = [data[offset + i * charsize:offset + (i + 1) * charsize]
+           for i in range(count)]
+    codes = [[i] for i in range(count)]
+
+    if has_table:
+        codes = []
+        pos = table
+        for i in range(count):
+            glyph_codes = []
+            if data[:2] == PSF1_MAGIC:
+                # UCS-2 entries, 0xFFFE starts sequences, 0xFFFF ends glyph
+                seq = False
+                while pos + 1 < len(data):
+                    (u,) = struct.unpack("<H", data[pos:pos + 2])
+                    pos += 2
+                    if u == 0xFFFF:
+                        break
+                    if u == 0xFFFE:
+                        seq = True
+                    elif not seq:
+                        glyph_codes.append(u)
+            else:
+                # UTF-8 entries, 0xFE starts sequences, 0xFF ends glyph
+                end = data.index(b"\xff", pos)
+                entry = data[pos:end].split(b"\xfe")[0]
+                glyph_codes = [ord(c) for c in entry.decode("utf-8")]
+                pos = end + 1
+            codes.append(glyph_codes)
+
+    cells = {}
+    for i in range(count):
+        cell = psf_glyph(raw[i], width, height)
+        for u in codes[i]:
+            cells.setdefault(u, (cell, width))
+
+    return cells
+
+
+def read_font(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if data[:2] == PSF1_MAGIC or data[:4] == PSF2_MAGIC:
+        return read_psf(data)
+
+    if data.lstrip().startswith(b"STARTFONT"):
+        return read_bdf(data)
+
+    raise ValueError("unknown font format (BDF or PSF expected)")
+
+
+def ink_box(cells):
+    """Common bounding box of ink - left, top, right, bottom (inclusive)."""
+    box = None
+    for cell, advance in cells:
+        for r, row in enumerate(cell):
+            for c, bit in enumerate(row):
+                if bit:
+                    if box is None:
+                        box = [c, r, c, r]
+                    box = [min(box[0], c), min(box[1], r),
+                           max(box[2], c), max(box[3], r)]
+    return box or [0, 0, 0, 0]
+
+
+def columns(cell, left, top):
+    """5 glyph columns of the cell window at left, top - bit 0 is the top
+    row."""
+    cols = []
+    for c in range(left, left + 5):
+        bits = 0
+        for r in range(7):
+            row = cell[top + r] if 0 <= top + r < len(cell) else []
+            if 0 <= c < len(row) and row[c]:
+                bits |= 1 << r
+        cols.append(bits)
+    return cols
+
+
+def metrics(cols, space):
+    """First column (high nibble) and width (low nibble) of the ink, blank
+    glyphs take space columns."""
+    used = [i for i, bits in enumerate(cols) if bits]
+    if not used:
+        return space
+    return (used[0] << 4) | (used[-1] - used[0] + 1)
+
+
+def ranges(codes):
+    """Runs of consecutive codes - (first, last, glyph index)."""
+    runs = []
+    for idx, code in enumerate(codes):
+        if runs and runs[-1][1] + 1 == code:
+            runs[-1][1] = code
+        else:
+            runs.append([code, code, idx])
+    return runs
+
+
+def compile_font(args):
+    cells = read_font(args.font)
+    encode = lambda code: ord(bytes([code]).decode(args.encoding, "replace"))
+
+    if args.chars is not None or args.text:
+        used = set((args.chars or "").encode(args.encoding))
+        for path in args.text or []:
+            with open(path, "rb") as f:
+                used |= set(f.read())
+        used = set(c for c in used if c >= 32)
+    else:
+        used = set(c for c in range(32, 256) if encode(c) in cells and
+                   (c == 32 or any(map(any, cells[encode(c)][0]))))
+
+    default = args.default.encode(args.encoding)[0]
+    used.add(default)
+
+    missing = sorted(c for c in used if encode(c) not in cells)
+    if default in missing:
+        raise ValueError("font has no default glyph %r" % args.default)
+    if missing:
+        sys.stderr.write("c7x10y_font.py: no glyph for codes %s, default "
+                         "glyph used\n" % ", ".join(str(c) for c in missing))
+
+    codes = sorted(c for c in used if c not in missing)
+
+    # Box of ASCII glyphs too, so placement does not depend on the subset
+    boxed = set(codes) | set(c for c in range(32, 127) if encode(c) in cells)
+    box = ink_box(cells[encode(c)] for c in boxed)
+    size = (box[2] - box[0] + 1, box[3] - box[1] + 1)
+
+    if (size[0] > 5 or size[1] > 7) and not args.clip:
+        raise ValueError("glyphs take %dx%d pixels, 5x7 fits the display "
+                         "(--clip cuts them)" % size)
+
+    # Glyphs are aligned to the left and the bottom of the ink box
+    left = box[0]
+    top = box[3] - 6
+    glyphs = [columns(cells[encode(c)][0], left, top) for c in codes]
+
+    return codes, glyphs, [metrics(g, args.space) for g in glyphs], size
+
+
+def emit(args, codes, glyphs, widths):
+    name = args.name
+    runs = ranges(codes)
+    default = codes.index(args.default.encode(args.encoding)[0])
+    source = os.path.basename(args.font)
+    guard = "_%s_H_" % name.upper()
+
+    out = ["/*",
+           " * %s - generated by c7x10y_font.py from %s, %d glyph(s)." %
+           (name, source, len(codes)),
+           " * Include after __c7x10y_driver.h.",
+           " */",
+           "#ifndef %s" % guard,
+           "#define %s" % guard,
+           "",
+           "const unsigned char %sGlyphs[ %d * 5 ] = {" % (name, len(codes))]
+
+    for i, (code, cols) in enumerate(zip(codes, glyphs)):
+        last = i == len(codes) - 1
+        out.append("   %s%s   // Code for char num %d" %
+                   (",".join("0x%02X" % b for b in cols), " " if last else ",",
+                    code))
+
+    out.append("};")
+
+    if args.proportional:
+        out += ["", "const unsigned char %sMetrics[ %d ] = {" %
+                (name, len(codes))]
+        for i in range(0, len(widths), 16):
+            row = widths[i:i + 16]
+            last = i + 16 >= len(widths)
+            out.append("   %s%s" % (",".join("0x%02X" % w for w in row),
+                                    " " if last else ","))
+        out.append("};")
+
+    out += ["", "const T_c7x10y_range %sRanges[ %d ] = {" % (name, len(runs))]
+    for i, (first, last, idx) in enumerate(runs):
+        out.append("   { %d, %d, %d }%s" %
+                   (first, last, idx, "," if i < len(runs) - 1 else ""))
+    out.append("};")
+
+    out += ["",
+            "const T_c7x10y_font %s = { %sGlyphs, %s, 0, %sRanges, %d, %d };" %
+            (name, name, name + "Metrics" if args.proportional else "0",
+             name, len(runs), default),
+            "",
+            "#endif"]
+
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__.split("\n\n")[1].strip())
+    parser.add_argument("font", help="BDF or PSF font file")
+    parser.add_argument("--chars", help="characters to compile")
+    parser.add_argument("--text", action="append",
+                        help="file with the messages, all characters in it "
+                             "are compiled (repeatable)")
+    parser.add_argument("--proportional", action="store_true",
+                        help="add metrics for c7x10y proportional text")
+    parser.add_argument("--space", type=int, default=2, choices=range(6),
+                        help="width of blank proportional glyphs")
+    parser.add_argument("--encoding", default="latin-1",
+                        help="code page of the firmware strings")
+    parser.add_argument("--default", default="?",
+                        help="glyph drawn for codes out of the font")
+    parser.add_argument("--name", help="font name (default file name)")
+    parser.add_argument("--clip", action="store_true",
+                        help="cut glyphs larger than 5x7")
+    parser.add_argument("-o", "--output", help="output file (default stdout)")
+    args = parser.parse_args()
+
+    if not args.name:
+        base = os.path.splitext(os.path.basename(args.font))[0]
+        args.name = "font_" + re.sub(r"\W", "_", base)
+
+    try:
+        codes, glyphs, widths, size = compile_font(args)
+        lines = emit(args, codes, glyphs, widths)
+    except (OSError, ValueError, LookupError) as e:
+        sys.exit("c7x10y_font.py: %s" % e)
+
+    text = "\n".join(lines) + "\n"
+
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()
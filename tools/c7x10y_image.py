@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""
+    c7x10y_image.py
+
+    Converts PBM (P1 or P4) or ASCII art images to constant arrays for the
+    7x10_Y click driver.
+
+    Image mode (default) - 7 rows of one word per panel, for
+    c7x10y_drawImage. Width is padded to whole panels (10 columns), the
+    number of panels is defined as NAME_PANELS and passed to
+    c7x10y_drawImage along with the array.
+
+    Bitmap mode (--bitmap) - ( w + 7 ) / 8 bytes per row, for c7x10y_blit.
+    Width can be 1 to 16.
+
+    In ASCII art '#', 'X', '*' and '1' are lit pixels, anything else is dark.
+
+    Usage:
+        c7x10y_image.py [--bitmap] [--name NAME] [-o OUT] IMAGE
+"""
+
+import argparse
+import os
+import re
+import sys
+
+
+def read_pbm(data):
+    """Returns rows of pixels (list of lists of 0/1) from PBM data."""
+    magic = data[:2]
+    fields = []
+    pos = 2
+
+    # Header fields - width and height, comments start with '#'
+    while len(fields) < 2:
+        match = re.compile(rb"\s*(?:#[^\n]*\n\s*)*(\d+)").match(data, pos)
+        if match is None:
+            raise ValueError("malformed PBM header")
+        fields.append(int(match.group(1)))
+        pos = match.end()
+
+    width, height = fields
+
+    if magic == b"P1":
+        bits = [int(c) for c in re.sub(rb"#[^\n]*", b"", data[pos:]).decode()
+                if c in "01"]
+        if len(bits) < width * height:
+            raise ValueError("PBM data too short")
+        return [bits[r * width:(r + 1) * width] for r in range(height)]
+
+    # P4 - single whitespace after the header, rows padded to whole bytes
+    pos += 1
+    stride = (width + 7) // 8
+    rows = []
+
+    for r in range(height):
+        row = data[pos + r * stride:pos + (r + 1) * stride]
+        if len(row) < stride:
+            raise ValueError("PBM data too short")
+        rows.append([(row[c >> 3] >> (7 - (c & 7))) & 1 for c in range(width)])
+
+    return rows
+
+
+def read_ascii(text):
+    """Returns rows of pixels from ASCII art, trailing empty lines dropped."""
+    lines = text.rstrip("\n").split("\n")
+    width = max(len(line) for line in lines)
+
+    return [[1 if c in "#X*1" else 0 for c in line.ljust(width)]
+            for line in lines]
+
+
+def read_image(path):
+    with open(path, "rb") as f:
+        data = f.read()
+
+    if data[:2] in (b"P1", b"P4"):
+        return read_pbm(data)
+
+    return read_ascii(data.decode())
+
+
+def pack_image(rows):
+    """Packs rows into panel words, bit 0 is the leftmost column."""
+    if len(rows) != 7:
+        raise ValueError("image must be 7 rows high, got %d" % len(rows))
+
+    panels = (len(rows[0]) + 9) // 10
+    words = []
+
+    for row in rows:
+        row = row + [0] * (panels * 10 - len(row))
+        for panel in range(panels):
+            words.append(sum(bit << i for i, bit in
+                             enumerate(row[panel * 10:panel * 10 + 10])))
+
+    return panels, words
+
+
+def pack_bitmap(rows):
+    """Packs rows into blit bytes, bit 0 of the first byte is the leftmost
+    column."""
+    width = len(rows[0])
+
+    if not 1 <= width <= 16:
+        raise ValueError("bitmap must be 1 to 16 columns wide, got %d" % width)
+
+    stride = (width + 7) // 8
+    data = []
+
+    for row in rows:
+        bits = sum(bit << i for i, bit in enumerate(row))
+        data.extend((bits >> (8 * i)) & 0xFF for i in range(stride))
+
+    return width, stride, data
+
+
+def art(row):
+    return "".join("#" if bit else "." for bit in row)
+
+
+def emit_image(name, source, rows):
+    panels, words = pack_image(rows)
+    count = "%s_PANELS" % name.upper()
+    out = ["/* %s - generated by c7x10y_image.py */" % source,
+           "#define %s %d" % (count, panels),
+           "const uint16_t %s[ 7 * %s ] =" % (name, count),
+           "{"]
+
+    for r, row in enumerate(rows):
+        line = ", ".join("0x%04X" % w for w in words[r * panels:(r + 1) * panels])
+        out.append("    %s%s    /* %s */" % (line, "," if r < 6 else " ", art(row)))
+
+    out.append("};")
+    return out
+
+
+def emit_bitmap(name, source, rows):
+    width, stride, data = pack_bitmap(rows)
+    out = ["/* %s - generated by c7x10y_image.py, w = %d, h = %d */" %
+           (source, width, len(rows)),
+           "const uint8_t %s[ %d ] =" % (name, stride * len(rows)),
+           "{"]
+
+    for r, row in enumerate(rows):
+        line = ", ".join("0x%02X" % b for b in data[r * stride:(r + 1) * stride])
+        last = r == len(rows) - 1
+        out.append("    %s%s    /* %s */" % (line, " " if last else ",", art(row)))
+
+    out.append("};")
+    return out
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[1].strip())
+    parser.add_argument("image", help="PBM (P1/P4) or ASCII art file")
+    parser.add_argument("--bitmap", action="store_true",
+                        help="blit bitmap instead of the full display image")
+    parser.add_argument("--name", help="array name (default file name)")
+    parser.add_argument("-o", "--output", help="output file (default stdout)")
+    args = parser.parse_args()
+
+    source = os.path.basename(args.image)
+    name = args.name or re.sub(r"\W", "_", os.path.splitext(source)[0])
+
+    try:
+        rows = read_image(args.image)
+        emit = emit_bitmap if args.bitmap else emit_image
+        lines = emit(name, source, rows)
+    except (OSError, ValueError) as e:
+        sys.exit("c7x10y_image.py: %s" % e)
+
+    text = "\n".join(lines) + "\n"
+
+    if args.output:
+        with open(args.output, "w") as f:
+            f.write(text)
+    else:
+        sys.stdout.write(text)
+
+
+if __name__ == "__main__":
+    main()